@@ -0,0 +1,257 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RequiredProgramMainCPPInclude.h"
+#include "HAL/FileManager.h"
+#include "Readers/PSAReader.h"
+#include "Readers/PSKReader.h"
+#include "Utils/ActorXSyntheticFiles.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogActorXReaderBenchmark, Log, All);
+
+IMPLEMENT_APPLICATION(ActorXReaderBenchmark, "ActorXReaderBenchmark");
+
+/** Samples of one measured step, bytes and elements are per sample */
+struct FBenchmarkTiming
+{
+	int64 Bytes = 0;
+	int64 Elements = 0;
+	TArray<double> Seconds;
+};
+
+/** Steps in the order they were first measured */
+using FBenchmarkTimings = TMap<FString, FBenchmarkTiming>;
+
+static void AddSample(FBenchmarkTimings& Timings, const FString& Name, int64 Bytes, int64 Elements, double Seconds)
+{
+	auto& Timing = Timings.FindOrAdd(Name);
+	Timing.Bytes = Bytes;
+	Timing.Elements = Elements;
+	Timing.Seconds.Add(Seconds);
+}
+
+static void LogTimings(const FString& Title, const FBenchmarkTimings& Timings)
+{
+	UE_LOG(LogActorXReaderBenchmark, Display, TEXT("%s"), *Title);
+	for (const auto& [Name, Timing] : Timings)
+	{
+		// The median is less sensitive to the first, cold iteration than the mean
+		auto Seconds = Timing.Seconds;
+		Seconds.Sort();
+		const auto Median = FMath::Max(Seconds[Seconds.Num() / 2], UE_DOUBLE_SMALL_NUMBER);
+
+		UE_LOG(LogActorXReaderBenchmark, Display, TEXT("  %s: %.3f ms, %.1f MB/s, %.2f M elements/s (%lld bytes, %lld elements)"),
+			*Name, Median * 1000.0, Timing.Bytes / (1024.0 * 1024.0) / Median, Timing.Elements / 1000000.0 / Median, Timing.Bytes, Timing.Elements);
+	}
+}
+
+static void LogMemory(uint64 BaselineMemory)
+{
+	const auto Stats = FPlatformMemory::GetStats();
+	UE_LOG(LogActorXReaderBenchmark, Display, TEXT("  Peak memory: %.1f MB used physical, %.1f MB above baseline"),
+		Stats.PeakUsedPhysical / (1024.0 * 1024.0), (Stats.PeakUsedPhysical - FMath::Min(BaselineMemory, Stats.PeakUsedPhysical)) / (1024.0 * 1024.0));
+}
+
+/** Times the whole read and then every chunk type on its own, chunks with the same id are decoded together */
+template <typename TReader>
+static bool BenchmarkReader(const FString& Filename, int32 Iterations, FBenchmarkTimings& Timings)
+{
+	for (auto Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		int64 TotalBytes = 0;
+		int64 TotalElements = 0;
+
+		auto Reader = TReader(Filename);
+		auto StartTime = FPlatformTime::Seconds();
+		if (!Reader.Open())
+		{
+			return false;
+		}
+		const auto& Chunks = Reader.GetDirectory().GetChunks();
+		AddSample(Timings, TEXT("Directory"), IFileManager::Get().FileSize(*Filename), Chunks.Num(), FPlatformTime::Seconds() - StartTime);
+
+		TSet<uint64> ReadChunks;
+		for (const auto& Chunk : Chunks)
+		{
+			if (ReadChunks.Contains(Chunk.Id))
+			{
+				continue;
+			}
+			ReadChunks.Add(Chunk.Id);
+
+			int64 Bytes = 0;
+			int64 Elements = 0;
+			for (const auto& Other : Chunks)
+			{
+				if (Other.Is(Chunk.Id))
+				{
+					Bytes += Other.GetDataBytes();
+					Elements += Other.DataCount;
+				}
+			}
+
+			if (Bytes == 0)
+			{
+				continue;
+			}
+
+			StartTime = FPlatformTime::Seconds();
+			if (!Reader.ReadChunk(Chunk.Id))
+			{
+				return false;
+			}
+			AddSample(Timings, ANSI_TO_TCHAR(Chunk.ChunkID), Bytes, Elements, FPlatformTime::Seconds() - StartTime);
+
+			TotalBytes += Bytes;
+			TotalElements += Elements;
+		}
+		Reader.Close();
+
+		auto FullReader = TReader(Filename);
+		StartTime = FPlatformTime::Seconds();
+		if (!FullReader.Read())
+		{
+			return false;
+		}
+		AddSample(Timings, TEXT("Read"), TotalBytes, TotalElements, FPlatformTime::Seconds() - StartTime);
+	}
+
+	return true;
+}
+
+/** Times the per sequence track decoding the PSA importer uses instead of reading ANIMKEYS in one go */
+static bool BenchmarkTracks(const FString& Filename, int32 Iterations, FBenchmarkTimings& Timings)
+{
+	for (auto Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		auto Reader = PSAReader(Filename);
+		if (!Reader.Open() || !Reader.ReadChunk(ActorXChunkId("ANIMINFO")) || !Reader.ReadChunk(ActorXChunkId("BONENAMES")))
+		{
+			return false;
+		}
+
+		int64 Bytes = 0;
+		int64 Elements = 0;
+		for (const auto& Chunk : Reader.GetDirectory().GetChunks())
+		{
+			if (Chunk.Is(ActorXChunkId("ANIMKEYS")) || Chunk.Is(ActorXChunkId("SCALEKEYS")))
+			{
+				Bytes += Chunk.GetDataBytes();
+				Elements += Chunk.DataCount;
+			}
+		}
+
+		TArray<FPSABoneTrack> Tracks;
+		const auto StartTime = FPlatformTime::Seconds();
+		for (const auto& Info : Reader.AnimInfo)
+		{
+			if (!Reader.ReadSequenceTracks(Info, Tracks))
+			{
+				return false;
+			}
+		}
+		AddSample(Timings, TEXT("Sequence tracks"), Bytes, Elements, FPlatformTime::Seconds() - StartTime);
+	}
+
+	return true;
+}
+
+/** The properties file is loaded before the mesh, so it is measured on a PSK without any chunks */
+static bool BenchmarkProps(const FString& Filename, int32 NumSockets, int32 Iterations, FBenchmarkTimings& Timings)
+{
+	const auto Bytes = IFileManager::Get().FileSize(*FPaths::ChangeExtension(Filename, TEXT("props.txt")));
+	for (auto Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		auto Reader = PSKReader(Filename, true);
+		const auto StartTime = FPlatformTime::Seconds();
+		if (!Reader.Read() || Reader.Sockets.Num() != NumSockets)
+		{
+			return false;
+		}
+		AddSample(Timings, TEXT("Properties"), Bytes, NumSockets, FPlatformTime::Seconds() - StartTime);
+	}
+
+	return true;
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	FTaskTagScope Scope(ETaskTag::EGameThread);
+	ON_SCOPE_EXIT
+	{
+		RequestEngineExit(TEXT("Exiting"));
+		FEngineLoop::AppPreExit();
+		FModuleManager::Get().UnloadModulesAtShutdown();
+		FEngineLoop::AppExit();
+	};
+
+	if (const auto Result = GEngineLoop.PreInit(ArgC, ArgV))
+	{
+		return Result;
+	}
+
+	const auto CommandLine = FCommandLine::Get();
+
+	FActorXSyntheticParams Params;
+	Params.ParseCommandLine(CommandLine);
+
+	auto Iterations = 5;
+	FParse::Value(CommandLine, TEXT("-Iterations="), Iterations);
+	Iterations = FMath::Max(Iterations, 1);
+
+	auto OutputDir = FPaths::Combine(FPlatformProcess::UserTempDir(), TEXT("ActorXReaderBenchmark"));
+	FParse::Value(CommandLine, TEXT("-Output="), OutputDir);
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+	const auto PSKFile = FPaths::Combine(OutputDir, TEXT("Synthetic.psk"));
+	const auto PSKXFile = FPaths::Combine(OutputDir, TEXT("Synthetic.pskx"));
+	const auto PSAFile = FPaths::Combine(OutputDir, TEXT("Synthetic.psa"));
+	const auto PropsFile = FPaths::Combine(OutputDir, TEXT("SyntheticProps.psk"));
+
+	UE_LOG(LogActorXReaderBenchmark, Display, TEXT("Generating %s in %s"), *Params.ToString(), *OutputDir);
+	if (!FActorXSyntheticFiles::WritePSK(PSKFile, Params) || !FActorXSyntheticFiles::WritePSKX(PSKXFile, Params)
+		|| !FActorXSyntheticFiles::WritePSA(PSAFile, Params) || !FActorXSyntheticFiles::WriteProps(PropsFile, Params))
+	{
+		UE_LOG(LogActorXReaderBenchmark, Error, TEXT("Failed to write the synthetic files to %s"), *OutputDir);
+		return 1;
+	}
+
+	// Peak memory only ever grows, so each report includes everything measured before it
+	const auto BaselineMemory = FPlatformMemory::GetStats().PeakUsedPhysical;
+	auto bSuccess = true;
+
+	FBenchmarkTimings PSKTimings;
+	bSuccess &= BenchmarkReader<PSKReader>(PSKFile, Iterations, PSKTimings);
+	LogTimings(PSKFile, PSKTimings);
+	LogMemory(BaselineMemory);
+
+	FBenchmarkTimings PSKXTimings;
+	bSuccess &= BenchmarkReader<PSKReader>(PSKXFile, Iterations, PSKXTimings);
+	LogTimings(PSKXFile, PSKXTimings);
+	LogMemory(BaselineMemory);
+
+	FBenchmarkTimings PSATimings;
+	bSuccess &= BenchmarkReader<PSAReader>(PSAFile, Iterations, PSATimings);
+	bSuccess &= BenchmarkTracks(PSAFile, Iterations, PSATimings);
+	LogTimings(PSAFile, PSATimings);
+	LogMemory(BaselineMemory);
+
+	FBenchmarkTimings PropsTimings;
+	bSuccess &= BenchmarkProps(PropsFile, Params.Sockets, Iterations, PropsTimings);
+	LogTimings(FPaths::ChangeExtension(PropsFile, TEXT("props.txt")), PropsTimings);
+	LogMemory(BaselineMemory);
+
+	if (!FParse::Param(CommandLine, TEXT("Keep")))
+	{
+		for (const auto& File : { PSKFile, PSKXFile, PSAFile, PropsFile, FPaths::ChangeExtension(PropsFile, TEXT("props.txt")) })
+		{
+			IFileManager::Get().Delete(*File);
+		}
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogActorXReaderBenchmark, Error, TEXT("One of the synthetic files failed to read"));
+	}
+
+	return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class ActorXReaderCLITarget : TargetRules
+{
+	public ActorXReaderCLITarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "ActorXReaderCLI";
+		DefaultBuildSettings = BuildSettingsVersion.Latest;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Latest;
+
+		// Core only, no UObjects, engine or UI so it runs on headless machines
+		bBuildDeveloperTools = false;
+		bBuildWithEditorOnlyData = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bCompileICU = false;
+		bUseMallocProfiler = false;
+		bIsBuildingConsoleApplication = true;
+
+		EnablePlugins.Add("UnrealPSKPSA");
+	}
+}
@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RequiredProgramMainCPPInclude.h"
+#include "Readers/PSAReader.h"
+#include "Readers/PSKReader.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogActorXReaderCLI, Log, All);
+
+IMPLEMENT_APPLICATION(ActorXReaderCLI, "ActorXReaderCLI");
+
+template <typename TReader>
+static bool ReadFile(const FString& Filename)
+{
+	auto Reader = TReader(Filename);
+	if (!Reader.Open())
+	{
+		return false;
+	}
+
+	int64 TotalBytes = 0;
+	for (const auto& Chunk : Reader.GetDirectory().GetChunks())
+	{
+		UE_LOG(LogActorXReaderCLI, Display, TEXT("  %hs: %d x %d bytes"), Chunk.ChunkID, Chunk.DataCount, Chunk.DataSize);
+		TotalBytes += Chunk.GetDataBytes();
+	}
+	Reader.Close();
+
+	const auto StartTime = FPlatformTime::Seconds();
+	const auto bSuccess = Reader.Read();
+	const auto Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogActorXReaderCLI, Display, TEXT("%s %s in %.3f ms, %.1f MB/s"), bSuccess ? TEXT("Read") : TEXT("Failed to read"), *Filename,
+		Elapsed * 1000.0, Elapsed > 0.0 ? TotalBytes / (1024.0 * 1024.0) / Elapsed : 0.0);
+	return bSuccess;
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	FTaskTagScope Scope(ETaskTag::EGameThread);
+	ON_SCOPE_EXIT
+	{
+		RequestEngineExit(TEXT("Exiting"));
+		FEngineLoop::AppPreExit();
+		FModuleManager::Get().UnloadModulesAtShutdown();
+		FEngineLoop::AppExit();
+	};
+
+	if (const auto Result = GEngineLoop.PreInit(ArgC, ArgV))
+	{
+		return Result;
+	}
+
+	TArray<FString> Files;
+	for (auto ArgIndex = 1; ArgIndex < ArgC; ArgIndex++)
+	{
+		if (ArgV[ArgIndex][0] != TEXT('-'))
+		{
+			Files.Add(ArgV[ArgIndex]);
+		}
+	}
+
+	if (Files.IsEmpty())
+	{
+		UE_LOG(LogActorXReaderCLI, Display, TEXT("Usage: ActorXReaderCLI <file.psk|file.pskx|file.psa>..."));
+		return 1;
+	}
+
+	auto bSuccess = true;
+	for (const auto& File : Files)
+	{
+		const auto Extension = FPaths::GetExtension(File);
+		if (Extension == TEXT("psk") || Extension == TEXT("pskx"))
+		{
+			bSuccess &= ReadFile<PSKReader>(File);
+		}
+		else if (Extension == TEXT("psa"))
+		{
+			bSuccess &= ReadFile<PSAReader>(File);
+		}
+		else
+		{
+			UE_LOG(LogActorXReaderCLI, Error, TEXT("Unknown ActorX file type: %s"), *File);
+			bSuccess = false;
+		}
+	}
+
+	return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,279 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/ImportActorXCommandlet.h"
+#include "Factories/PSAFactory.h"
+#include "Factories/PSKFactory.h"
+#include "Factories/PSKXFactory.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "ObjectTools.h"
+#include "Readers/PSAReader.h"
+#include "Readers/PSKReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utils/ActorXDecodeQueue.h"
+#include "Utils/ActorXImportReport.h"
+#include "Widgets/PSAImportOptions.h"
+#include "Widgets/PSKImportOptions.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogImportActorXCommandlet, Log, All);
+
+/** A file read on a worker thread, only one of the readers is set */
+struct FActorXDecodedFile
+{
+	TUniquePtr<PSKReader> Mesh;
+	TUniquePtr<PSAReader> Anim;
+	bool bSuccess = false;
+	double ReadSeconds = 0.0;
+};
+
+static FActorXDecodedFile DecodeFile(const FString& Filename, bool bLoadMeshProperties, bool bLoadAnimProperties)
+{
+	FActorXDecodedFile Decoded;
+	const auto StartTime = FPlatformTime::Seconds();
+
+	const auto Extension = FPaths::GetExtension(Filename);
+	if (Extension == TEXT("psk") || Extension == TEXT("pskx"))
+	{
+		// Properties are only used by skeletal meshes
+		Decoded.Mesh = MakeUnique<PSKReader>(Filename, bLoadMeshProperties && Extension == TEXT("psk"));
+		Decoded.bSuccess = Decoded.Mesh->ReadConverted();
+	}
+	else if (Extension == TEXT("psa"))
+	{
+		// Keys are streamed while the sequences are created, so the file or its cache entry stays open until then
+		Decoded.Anim = MakeUnique<PSAReader>(Filename, bLoadAnimProperties);
+		Decoded.bSuccess = Decoded.Anim->OpenConverted();
+	}
+
+	Decoded.ReadSeconds = FPlatformTime::Seconds() - StartTime;
+	return Decoded;
+}
+
+static bool IsActorXFile(const FString& Filename)
+{
+	const auto Extension = FPaths::GetExtension(Filename);
+	return Extension == TEXT("psk") || Extension == TEXT("pskx") || Extension == TEXT("psa");
+}
+
+static void SaveDirtyPackages()
+{
+	TArray<UPackage*> Packages;
+	FEditorFileUtils::GetDirtyContentPackages(Packages);
+	UEditorLoadingAndSavingUtils::SavePackages(Packages, true);
+}
+
+UImportActorXCommandlet::UImportActorXCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UImportActorXCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	auto Source = ParamVals.FindRef(TEXT("Source"));
+	FPaths::NormalizeDirectoryName(Source);
+	const auto Dest = ParamVals.Contains(TEXT("Dest")) ? ParamVals[TEXT("Dest")] : TEXT("/Game/ActorX");
+	const auto OptionsFile = ParamVals.FindRef(TEXT("Options"));
+	const auto bSave = !Switches.Contains(TEXT("NoSave"));
+
+	if (Switches.Contains(TEXT("ImportReport")))
+	{
+		IConsoleManager::Get().FindConsoleVariable(TEXT("ActorX.ImportReport"))->Set(true);
+	}
+
+	auto MaxInFlight = TActorXDecodeQueue<FActorXDecodedFile>::GetDefaultMaxInFlight();
+	if (ParamVals.Contains(TEXT("MaxInFlight")))
+	{
+		MaxInFlight = FMath::Max(1, FCString::Atoi(*ParamVals[TEXT("MaxInFlight")]));
+	}
+
+	auto SaveInterval = 100;
+	if (ParamVals.Contains(TEXT("SaveInterval")))
+	{
+		SaveInterval = FMath::Max(1, FCString::Atoi(*ParamVals[TEXT("SaveInterval")]));
+	}
+
+	if (Source.IsEmpty())
+	{
+		UE_LOG(LogImportActorXCommandlet, Error, TEXT("Usage: -run=ImportActorX -Source=<directory or manifest> [-Dest=/Game/ActorX] [-Options=<options.json>] [-MaxInFlight=N] [-SaveInterval=N] [-NoSave] [-ImportReport]"));
+		return 1;
+	}
+
+	if (!LoadOptions(OptionsFile))
+	{
+		return 1;
+	}
+
+	// Each file is imported into Dest, files found in a directory keep their relative folder
+	TArray<FString> Files;
+	TArray<FString> PackagePaths;
+	if (FPaths::DirectoryExists(Source))
+	{
+		IFileManager::Get().FindFilesRecursive(Files, *Source, TEXT("*.*"), true, false);
+		Files.RemoveAll([](const FString& File) { return !IsActorXFile(File); });
+		Files.Sort();
+
+		for (const auto& File : Files)
+		{
+			auto RelativePath = FPaths::GetPath(File);
+			RelativePath.RemoveFromStart(Source);
+			RelativePath.RemoveFromStart(TEXT("/"));
+			PackagePaths.Add(FPaths::Combine(Dest, RelativePath));
+		}
+	}
+	else
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *Source))
+		{
+			UE_LOG(LogImportActorXCommandlet, Error, TEXT("Failed to read the manifest %s"), *Source);
+			return 1;
+		}
+
+		for (auto Line : Lines)
+		{
+			Line.TrimStartAndEndInline();
+			if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+			{
+				continue;
+			}
+
+			if (FPaths::IsRelative(Line))
+			{
+				Line = FPaths::Combine(FPaths::GetPath(Source), Line);
+			}
+
+			if (!IsActorXFile(Line))
+			{
+				UE_LOG(LogImportActorXCommandlet, Warning, TEXT("Skipping %s, it is not an ActorX file"), *Line);
+				continue;
+			}
+
+			Files.Add(Line);
+			PackagePaths.Add(Dest);
+		}
+	}
+
+	UE_LOG(LogImportActorXCommandlet, Display, TEXT("Importing %d files into %s"), Files.Num(), *Dest);
+
+	const auto bLoadMeshProperties = PSKOptions->bLoadProperties;
+	const auto bLoadAnimProperties = PSAOptions->bLoadProperties;
+	TActorXDecodeQueue<FActorXDecodedFile> Queue(Files.Num(), MaxInFlight, [Files, bLoadMeshProperties, bLoadAnimProperties](int32 FileIndex)
+	{
+		return DecodeFile(Files[FileIndex], bLoadMeshProperties, bLoadAnimProperties);
+	});
+
+	auto NumFailed = 0;
+	for (auto FileIndex = 0; FileIndex < Files.Num(); FileIndex++)
+	{
+		const auto& Filename = Files[FileIndex];
+		auto Decoded = MoveTemp(Queue.GetNext());
+		Queue.PopNext();
+
+		if (!Decoded.bSuccess)
+		{
+			UE_LOG(LogImportActorXCommandlet, Error, TEXT("Failed to read %s"), *Filename);
+			NumFailed++;
+			continue;
+		}
+
+		const auto AssetName = ObjectTools::SanitizeObjectName(FPaths::GetBaseFilename(Filename));
+		const auto Parent = CreatePackage(*FPaths::Combine(PackagePaths[FileIndex], AssetName));
+		const auto Flags = RF_Public | RF_Standalone | RF_Transactional;
+
+		FActorXImportReport Report(Filename);
+		Report.AddPhase(TEXT("Read"), Decoded.ReadSeconds);
+
+		UObject* Asset = nullptr;
+		if (Decoded.Anim)
+		{
+			Report.AddChunks(Decoded.Anim->ChunkStats);
+			Asset = PSAFactory->CreateAnimSequences(*Decoded.Anim, Parent, Flags, PSAOptions, &Report);
+		}
+		else if (FPaths::GetExtension(Filename) == TEXT("pskx"))
+		{
+			Report.AddChunks(Decoded.Mesh->ChunkStats);
+			Asset = PSKXFactory->CreateStaticMesh(*Decoded.Mesh, Parent, FName(AssetName), Flags, PSKOptions, &Report);
+		}
+		else
+		{
+			Report.AddChunks(Decoded.Mesh->ChunkStats);
+			Asset = PSKFactory->CreateSkeletalMesh(*Decoded.Mesh, Parent, FName(AssetName), Flags, PSKOptions, &Report);
+		}
+
+		Report.SetAsset(Asset);
+		Report.Save();
+
+		if (Asset)
+		{
+			UE_LOG(LogImportActorXCommandlet, Display, TEXT("[%d/%d] Imported %s as %s"), FileIndex + 1, Files.Num(), *Filename, *Asset->GetPathName());
+		}
+		else
+		{
+			UE_LOG(LogImportActorXCommandlet, Error, TEXT("[%d/%d] Failed to import %s"), FileIndex + 1, Files.Num(), *Filename);
+			NumFailed++;
+		}
+
+		// Save and drop what has been imported so far so memory doesn't grow with the number of files
+		if (bSave && (FileIndex + 1) % SaveInterval == 0)
+		{
+			SaveDirtyPackages();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	if (bSave)
+	{
+		SaveDirtyPackages();
+	}
+
+	UE_LOG(LogImportActorXCommandlet, Display, TEXT("Imported %d of %d files"), Files.Num() - NumFailed, Files.Num());
+	return NumFailed > 0 ? 1 : 0;
+}
+
+bool UImportActorXCommandlet::LoadOptions(const FString& OptionsFile)
+{
+	PSKOptions = NewObject<UPSKImportOptions>(this);
+	PSAOptions = NewObject<UPSAImportOptions>(this);
+	PSKFactory = NewObject<UPSKFactory>(this);
+	PSKXFactory = NewObject<UPSKXFactory>(this);
+	PSAFactory = NewObject<UPSAFactory>(this);
+
+	if (OptionsFile.IsEmpty())
+	{
+		return true;
+	}
+
+	FString Json;
+	TSharedPtr<FJsonObject> Root;
+	if (!FFileHelper::LoadFileToString(Json, *OptionsFile) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+	{
+		UE_LOG(LogImportActorXCommandlet, Error, TEXT("Failed to read the options file %s"), *OptionsFile);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* Options = nullptr;
+	if (Root->TryGetObjectField(TEXT("PSK"), Options) && !FJsonObjectConverter::JsonObjectToUStruct(Options->ToSharedRef(), UPSKImportOptions::StaticClass(), PSKOptions.Get()))
+	{
+		UE_LOG(LogImportActorXCommandlet, Error, TEXT("Invalid PSK options in %s"), *OptionsFile);
+		return false;
+	}
+
+	if (Root->TryGetObjectField(TEXT("PSA"), Options) && !FJsonObjectConverter::JsonObjectToUStruct(Options->ToSharedRef(), UPSAImportOptions::StaticClass(), PSAOptions.Get()))
+	{
+		UE_LOG(LogImportActorXCommandlet, Error, TEXT("Invalid PSA options in %s"), *OptionsFile);
+		return false;
+	}
+
+	return true;
+}
@@ -1,7 +1,9 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Factories/PSAFactory.h"
+#include "UnrealPSKPSA.h"
 
+#include "Async/ParallelFor.h"
 #include "ComponentReregisterContext.h"
 #include "Widgets/PSAImportOptions.h"
 #include "Readers/PSAReader.h"
@@ -9,8 +11,48 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Interfaces/IMainFrameModule.h"
 #include "Misc/FeedbackContext.h"
+#include "Misc/App.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Utils/ActorXAssetImportData.h"
 #include "Utils/ActorXUtils.h"
+#include "Utils/ActorXImportReport.h"
+
+/** Replaces the keys of a sequence with the converted tracks of a PSA sequence, returns false without touching it if there isn't a track per bone */
+static bool PopulateSequence(UAnimSequence* AnimSequence, const PSAReader& Data, const VAnimInfoBinary& Info, const TArray<FPSABoneTrack>& Tracks)
+{
+	if (Tracks.Num() != Data.Bones.Num())
+	{
+		UE_LOG(LogActorXImport, Error, TEXT("%s has %d tracks for %d bones in %s"), ANSI_TO_TCHAR(Info.Name), Tracks.Num(), Data.Bones.Num(), *Data.GetFileName());
+		return false;
+	}
+
+	AnimSequence->GetController().OpenBracket(FText::FromString("Importing PSA Animation"));
+	AnimSequence->GetController().InitializeModel();
+	AnimSequence->ResetAnimation();
+
+	float AnimRate = Info.AnimRate;
+	if (!FMath::IsFinite(AnimRate))
+	{
+		AnimRate = 1.f;
+	}
+
+	AnimSequence->GetController().SetFrameRate(FFrameRate(AnimRate, 1));
+	AnimSequence->GetController().SetNumberOfFrames(FFrameNumber(Info.NumRawFrames));
+
+	for (auto BoneIndex = 0; BoneIndex < Data.Bones.Num(); BoneIndex++)
+	{
+		const auto BoneName = FName(Data.Bones[BoneIndex].Name);
+		const auto& Track = Tracks[BoneIndex];
+
+		AnimSequence->GetController().AddBoneCurve(BoneName);
+		AnimSequence->GetController().SetBoneTrackKeys(BoneName, Track.PositionalKeys, Track.RotationalKeys, Track.ScaleKeys);
+	}
+
+	AnimSequence->GetController().NotifyPopulated();
+	AnimSequence->GetController().CloseBracket();
+	AnimSequence->Modify(true);
+	return true;
+}
 
 /* UTextAssetFactory structors
  *****************************************************************************/
@@ -43,8 +85,44 @@ UObject* UPSAFactory::FactoryCreateFile(UClass* Class, UObject* Parent, FName Na
     }
     SlowTask.EnterProgressFrame(0);
 
-    // picker
-    if (SettingsImporter->bInitialized == false)
+	/* UFactory overrides
+	 *****************************************************************************/
+
+	// Cancel out the import
+	if (!ConfigureOptions())
+	{
+		return nullptr;
+	}
+
+	// Only the sequence table and bones are decoded up front, keys are streamed one sequence at a time
+	FActorXImportReport Report(Filename);
+	auto Data = PSAReader(Filename, SettingsImporter->bLoadProperties);
+	auto bRead = false;
+	{
+		FActorXImportReport::FPhase Phase(&Report, TEXT("Read"));
+		bRead = Data.OpenConverted();
+	}
+	Report.AddChunks(Data.ChunkStats);
+
+	// Failed imports are reported too, they have no asset
+	const auto AnimSequence = bRead ? CreateAnimSequences(Data, Parent, Flags, SettingsImporter, &Report) : nullptr;
+	Report.SetAsset(AnimSequence);
+	Report.Save();
+
+	if (!bImportAll)
+	{
+		SettingsImporter->bInitialized = false;
+	}
+
+	FGlobalComponentReregisterContext RecreateComponents;
+	
+	return AnimSequence;
+}
+
+bool UPSAFactory::ConfigureOptions()
+{
+    // picker, automated and unattended imports use the options as they are
+    if (SettingsImporter->bInitialized == false && !IsAutomatedImport() && !FApp::IsUnattended())
     {
         TSharedPtr<SPSAImportOption> ImportOptionsWindow;
         TSharedPtr<SWindow> ParentWindow;
@@ -70,99 +148,209 @@ UObject* UPSAFactory::FactoryCreateFile(UClass* Class, UObject* Parent, FName Na
         SettingsImporter->bInitialized = true;
     }
 
-	/* UFactory overrides
-	 *****************************************************************************/
+	return !bCancel;
+}
 
-	// Cancel out the import
-	if (bCancel)
+UAnimSequence* UPSAFactory::CreateAnimSequences(const PSAReader& Data, UObject* Parent, EObjectFlags Flags, const UPSAImportOptions* Options, FActorXImportReport* Report)
+{
+	UAnimSequence* AnimSequence = nullptr;
+
+	const auto NumBones = Data.Bones.Num();
+	const auto NumSequences = Data.AnimInfo.Num();
+
+	// Sequences are decoded and converted on the worker threads one batch at a time to keep memory bounded,
+	// only the UAnimSequence creation and the controller calls stay on the game thread
+	const auto BatchSize = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+	if (Report)
 	{
-		return nullptr;
+		Report->AddCount(TEXT("Bones"), NumBones);
+		Report->AddCount(TEXT("Sequences"), NumSequences);
+		Report->AddCount(TEXT("ParseCacheHit"), Data.bFromCache ? 1 : 0);
 	}
 
-	auto Data = PSAReader(Filename);
-	if (!Data.Read()) return nullptr;
+	FScopedSlowTask ImportTask(NumSequences, FText::FromString("Importing PSA Animation"));
+	ImportTask.MakeDialog(false);
 
-	UAnimSequence* AnimSequence = nullptr;
+	// Phases are summed over all batches
+	FActorXImportReport::FPhase Phase(Report, TEXT("DecodeTracks"));
 
-	for (int i = 0; i < Data.AnimInfo.Num(); i++)
+	TArray<TArray<FPSABoneTrack>> BatchTracks;
+	TArray<bool> BatchDecoded;
+	auto NumFailed = 0;
+	for (auto BatchStart = 0; BatchStart < NumSequences; BatchStart += BatchSize)
 	{
-		if (Data.AnimInfo.IsEmpty() || !Data.AnimInfo.IsValidIndex(i))
+		const auto BatchCount = FMath::Min(BatchSize, NumSequences - BatchStart);
+		BatchTracks.Reset();
+		BatchTracks.SetNum(BatchCount);
+		BatchDecoded.Init(false, BatchCount);
+
+		// Tracks come out converted, either from the parse cache or decoded and converted on the workers
+		Phase.Next(TEXT("DecodeTracks"));
+		ParallelFor(BatchCount, [&](int32 BatchIndex)
 		{
-			continue;
-		}
+			BatchDecoded[BatchIndex] = Data.ReadConvertedTracks(BatchStart + BatchIndex, BatchTracks[BatchIndex]);
+		});
 
-		VAnimInfoBinary Info = Data.AnimInfo[i];
+		Phase.Next(TEXT("AnimController"));
+		for (auto BatchIndex = 0; BatchIndex < BatchCount; BatchIndex++)
+		{
+			const auto& Info = Data.AnimInfo[BatchStart + BatchIndex];
 
-		AnimSequence = FActorXUtils::LocalCreate<UAnimSequence>(UAnimSequence::StaticClass(), Parent, ANSI_TO_TCHAR(Info.Name), Flags, SettingsImporter->bCreateFolder);
+			ImportTask.EnterProgressFrame(1, FText::FromString(FString::Printf(TEXT("Sequence %s: %d/%d"), ANSI_TO_TCHAR(Info.Name), BatchStart + BatchIndex + 1, NumSequences)));
 
-		USkeleton* Skeleton = SettingsImporter->Skeleton;
-		AnimSequence->SetSkeleton(Skeleton);
-	
-		AnimSequence->GetController().OpenBracket(FText::FromString("Importing PSA Animation"));
-		AnimSequence->GetController().InitializeModel();
-		AnimSequence->ResetAnimation();
-	
+			// A sequence with bad keys is skipped, the others in the file are still imported
+			const auto Created = BatchDecoded[BatchIndex] ? CreateAnimSequence(Data, BatchStart + BatchIndex, BatchTracks[BatchIndex], Parent, Flags, Options) : nullptr;
+			if (!Created)
+			{
+				UE_LOG(LogActorXImport, Error, TEXT("Failed to read the keys of %s from %s, skipping it"), ANSI_TO_TCHAR(Info.Name), *Data.GetFileName());
+				NumFailed++;
+				continue;
+			}
 
-		float AnimRate = Info.AnimRate;
-		if (!FMath::IsFinite(AnimRate))
-		{
-			AnimRate = 1.f;
+			AnimSequence = Created;
 		}
+	}
 
-		AnimSequence->GetController().SetFrameRate(FFrameRate(AnimRate, 1));
-		AnimSequence->GetController().SetNumberOfFrames(FFrameNumber(Info.NumRawFrames));
-	
-		FScopedSlowTask ImportTask(Data.Bones.Num(), FText::FromString("Importing PSA Animation"));
-		ImportTask.MakeDialog(false);
-		for (auto BoneIndex = 0; BoneIndex < Data.Bones.Num(); BoneIndex++)
-		{
+	if (Report)
+	{
+		Report->AddCount(TEXT("FailedSequences"), NumFailed);
+	}
 
-			auto Bone = Data.Bones[BoneIndex];
-			auto BoneName = FName(Bone.Name);
+	return AnimSequence;
+}
 
-			ImportTask.DefaultMessage = FText::FromString(FString::Printf(TEXT("Bone %s: %d/%d"), *BoneName.ToString(), BoneIndex+1, Data.Bones.Num()));
-			ImportTask.EnterProgressFrame();
+UAnimSequence* UPSAFactory::CreateAnimSequence(const PSAReader& Data, int32 SequenceIndex, const TArray<FPSABoneTrack>& Tracks, UObject* Parent, EObjectFlags Flags, const UPSAImportOptions* Options)
+{
+	const auto& Info = Data.AnimInfo[SequenceIndex];
 
-			TArray<FVector3f> PositionalKeys;
-			TArray<FQuat4f> RotationalKeys;
-			TArray<FVector3f> ScaleKeys;
-			for (auto Frame = 0; Frame < Info.NumRawFrames; Frame++)
-			{
-				auto KeyIndex = BoneIndex + (Info.FirstRawFrame + Frame) * Data.Bones.Num();
+	// Checked before the asset exists, so a bad sequence doesn't leave an empty one behind
+	if (Tracks.Num() != Data.Bones.Num())
+	{
+		return nullptr;
+	}
 
-				// Only continue if our bone actually has anim keys
-				if (Data.AnimKeys.IsValidIndex(KeyIndex))
-				{
-					auto AnimKey = Data.AnimKeys[KeyIndex];
+	const auto AnimSequence = FActorXUtils::LocalCreate<UAnimSequence>(UAnimSequence::StaticClass(), Parent, ANSI_TO_TCHAR(Info.Name), Flags, Options->bCreateFolder);
+	AnimSequence->SetSkeleton(Options->Skeleton);
+	PopulateSequence(AnimSequence, Data, Info, Tracks);
 
-					PositionalKeys.Add(FVector3f(AnimKey.Position.X, -AnimKey.Position.Y, AnimKey.Position.Z));
-					RotationalKeys.Add(FQuat4f(-AnimKey.Orientation.X, AnimKey.Orientation.Y, -AnimKey.Orientation.Z, (BoneIndex == 0) ? AnimKey.Orientation.W : -AnimKey.Orientation.W).GetNormalized());
-					ScaleKeys.Add(Data.bHasScaleKeys ? Data.ScaleKeys[KeyIndex].ScaleVector : FVector3f::OneVector);
-				}
-			}
+	// Every sequence is its own asset, so each one keeps the hash of its own keys
+	const auto ImportData = UActorXAssetImportData::GetOrCreate(AnimSequence, AnimSequence->AssetImportData);
+	ImportData->Update(Data.GetFileName());
+	ImportData->SetOptions(Options);
+	ImportData->PieceHashes = { { ActorXPieces::Sequence, UActorXAssetImportData::HashSequence(Data, SequenceIndex, Tracks) } };
+	AnimSequence->AssetImportData = ImportData;
 
-			AnimSequence->GetController().AddBoneCurve(BoneName);
-			AnimSequence->GetController().SetBoneTrackKeys(BoneName, PositionalKeys, RotationalKeys, ScaleKeys);
-		}
-	
-		AnimSequence->GetController().NotifyPopulated();
-		AnimSequence->GetController().CloseBracket();
-		AnimSequence->Modify(true);
+	AnimSequence->PostEditChange();
+	FAssetRegistryModule::AssetCreated(AnimSequence);
+	AnimSequence->MarkPackageDirty();
 
-		AnimSequence->PostEditChange();
-		FAssetRegistryModule::AssetCreated(AnimSequence);
-		AnimSequence->MarkPackageDirty();
+	return AnimSequence;
+}
 
+bool UPSAFactory::CanReimport(UObject* Obj, TArray<FString>& OutFilenames)
+{
+	const auto AnimSequence = Cast<UAnimSequence>(Obj);
+	const auto ImportData = AnimSequence ? Cast<UActorXAssetImportData>(AnimSequence->AssetImportData) : nullptr;
+	if (!ImportData)
+	{
+		return false;
 	}
 
-	if (!bImportAll)
+	ImportData->ExtractFilenames(OutFilenames);
+	return true;
+}
+
+void UPSAFactory::SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths)
+{
+	const auto AnimSequence = Cast<UAnimSequence>(Obj);
+	const auto ImportData = AnimSequence ? Cast<UActorXAssetImportData>(AnimSequence->AssetImportData) : nullptr;
+	if (ImportData && ensure(NewReimportPaths.Num() == 1))
 	{
-		SettingsImporter->bInitialized = false;
+		ImportData->UpdateFilenameOnly(NewReimportPaths[0]);
 	}
-
-	FGlobalComponentReregisterContext RecreateComponents;
-	
-	return AnimSequence;
 }
 
+EReimportResult::Type UPSAFactory::Reimport(UObject* Obj)
+{
+	const auto AnimSequence = Cast<UAnimSequence>(Obj);
+	const auto ImportData = AnimSequence ? Cast<UActorXAssetImportData>(AnimSequence->AssetImportData) : nullptr;
+	if (!ImportData)
+	{
+		return EReimportResult::Failed;
+	}
+
+	const auto Filename = ImportData->GetFirstFilename();
 
+	FActorXImportReport Report(Filename);
+	auto Data = PSAReader(Filename, ImportData->bLoadProperties);
+	auto bRead = false;
+	{
+		FActorXImportReport::FPhase Phase(&Report, TEXT("Read"));
+		bRead = Data.OpenConverted();
+	}
+	Report.AddChunks(Data.ChunkStats);
+
+	if (!bRead)
+	{
+		UE_LOG(LogActorXImport, Error, TEXT("Failed to reimport %s from %s"), *AnimSequence->GetPathName(), *Filename);
+		Report.Save();
+		return EReimportResult::Failed;
+	}
+
+	// Only the sequence this asset was created from is decoded
+	const auto SequenceIndex = Data.AnimInfo.IndexOfByPredicate([AnimSequence](const VAnimInfoBinary& Info)
+	{
+		return FName(ANSI_TO_TCHAR(Info.Name)) == AnimSequence->GetFName();
+	});
+
+	if (SequenceIndex == INDEX_NONE)
+	{
+		UE_LOG(LogActorXImport, Error, TEXT("%s doesn't have a sequence named %s anymore"), *Filename, *AnimSequence->GetName());
+		Report.Save();
+		return EReimportResult::Failed;
+	}
+
+	TArray<FPSABoneTrack> Tracks;
+	auto bDecoded = false;
+	{
+		FActorXImportReport::FPhase Phase(&Report, TEXT("DecodeTracks"));
+		bDecoded = Data.ReadConvertedTracks(SequenceIndex, Tracks);
+	}
+
+	if (!bDecoded)
+	{
+		UE_LOG(LogActorXImport, Error, TEXT("Failed to read the keys of %s from %s"), *AnimSequence->GetName(), *Filename);
+		Report.Save();
+		return EReimportResult::Failed;
+	}
+
+	const TMap<FName, uint64> NewHashes = { { ActorXPieces::Sequence, UActorXAssetImportData::HashSequence(Data, SequenceIndex, Tracks) } };
+	const auto bChanged = !ImportData->GetChangedPieces(NewHashes).IsEmpty();
+	Report.AddCount(TEXT("ChangedPieces"), bChanged ? 1 : 0);
+
+	if (bChanged)
+	{
+		FActorXImportReport::FPhase Phase(&Report, TEXT("AnimController"));
+		if (!PopulateSequence(AnimSequence, Data, Data.AnimInfo[SequenceIndex], Tracks))
+		{
+			Report.Save();
+			return EReimportResult::Failed;
+		}
+
+		AnimSequence->PostEditChange();
+		AnimSequence->MarkPackageDirty();
+	}
+
+	ImportData->Update(Filename);
+	ImportData->PieceHashes = NewHashes;
+
+	Report.SetAsset(AnimSequence);
+	Report.Save();
+	return EReimportResult::Succeeded;
+}
+
+int32 UPSAFactory::GetPriority() const
+{
+	return ImportPriority;
+}
@@ -1,7 +1,15 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Factories/PSKFactory.h"
+#include "UnrealPSKPSA.h"
+#include "Utils/ActorXAssetImportData.h"
 #include "Utils/ActorXUtils.h"
+#include "Utils/ActorXBoneTable.h"
+#include "Utils/ActorXConversion.h"
+#include "Utils/ActorXSkeletonIndex.h"
+#include "Utils/ActorXSkinWeights.h"
+#include "Utils/ActorXWedgeWelding.h"
+#include "Utils/ActorXImportReport.h"
 #include "IMeshBuilderModule.h"
 #include "Readers/PSKReader.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -13,10 +21,36 @@
 #include "Widgets/PSKImportOptions.h"
 #include "Widgets/SPSKImportOption.h"
 #include "Interfaces/IMainFrameModule.h"
+#include "Misc/App.h"
 #include "Misc/ScopedSlowTask.h"
 #include "Materials/Material.h"
 #include "MaterialDomain.h"
 
+static UMaterialInterface* GetImportMaterial(const VMaterial& PskMaterial, UObject* Parent, EObjectFlags Flags, const UPSKImportOptions* Options)
+{
+	if (Options->bCreateMaterials)
+	{
+		return FActorXUtils::LocalFindOrCreate<UMaterial>(UMaterial::StaticClass(), Parent, PskMaterial.MaterialName, Flags);
+	}
+
+	return UMaterial::GetDefaultMaterial(MD_Surface);
+}
+
+static void AddSockets(USkeletalMesh* SkeletalMesh, const PSKReader& Data)
+{
+	for (const auto& Socket : Data.Sockets)
+	{
+		USkeletalMeshSocket* NewSocket = NewObject<USkeletalMeshSocket>(SkeletalMesh);
+		NewSocket->SocketName = FName(Socket.SocketName);
+		NewSocket->BoneName = FName(Socket.BoneName);
+		NewSocket->RelativeLocation = Socket.RelativeLocation;
+		NewSocket->RelativeRotation = Socket.RelativeRotation;
+		NewSocket->RelativeScale = Socket.RelativeScale;
+
+		SkeletalMesh->AddSocket(NewSocket);
+	}
+}
+
 /* UTextAssetFactory structors
  *****************************************************************************/
 
@@ -44,8 +78,41 @@ UObject* UPSKFactory::FactoryCreateFile(UClass* Class, UObject* Parent, FName Na
 	}
 	SlowTask.EnterProgressFrame(0);
 
-	// picker
-	if (SettingsImporter->bInitialized == false)
+	// Cancel out the import
+	if (!ConfigureOptions())
+	{
+		return nullptr;
+	}
+
+	FActorXImportReport Report(Filename);
+	auto Data = PSKReader(Filename, SettingsImporter->bLoadProperties);
+	auto bRead = false;
+	{
+		FActorXImportReport::FPhase Phase(&Report, TEXT("Read"));
+		bRead = Data.ReadConverted();
+	}
+	Report.AddChunks(Data.ChunkStats);
+
+	// Failed imports are reported too, they have no asset
+	const auto SkeletalMesh = bRead ? CreateSkeletalMesh(Data, Parent, Name, Flags, SettingsImporter, &Report) : nullptr;
+	Report.SetAsset(SkeletalMesh);
+	Report.Save();
+	if (!SkeletalMesh) return nullptr;
+
+	if (!bImportAll)
+	{
+		SettingsImporter->bInitialized = false;
+	}
+
+	FGlobalComponentReregisterContext RecreateComponents;
+
+	return SkeletalMesh;
+}
+
+bool UPSKFactory::ConfigureOptions()
+{
+	// picker, automated and unattended imports use the options as they are
+	if (SettingsImporter->bInitialized == false && !IsAutomatedImport() && !FApp::IsUnattended())
 	{
 		TSharedPtr<SPSKImportOption> ImportOptionsWindow;
 		TSharedPtr<SWindow> ParentWindow;
@@ -69,130 +136,204 @@ UObject* UPSKFactory::FactoryCreateFile(UClass* Class, UObject* Parent, FName Na
 		SettingsImporter->bInitialized = true;
 	}
 
-	// Cancel out the import
-	if (bCancel)
+	return !bCancel;
+}
+
+void UPSKFactory::BuildImportData(PSKReader& Data, const UPSKImportOptions* Options, FSkeletalMeshImportData& SkeletalMeshImportData, TMap<FName, uint64>& OutPieceHashes, FActorXImportReport* Report)
+{
 	{
-		return nullptr;
+		FActorXImportReport::FPhase Phase(Report, TEXT("Convert"));
+		OutPieceHashes = FActorXUtils::PrepareMesh(Data, Options, Report);
 	}
 
-	auto Data = PSKReader(Filename, SettingsImporter->bLoadProperties);
-	if (!Data.Read()) return nullptr;
+	BuildImportData(Data, Options, SkeletalMeshImportData, Report);
+}
 
-	TArray<FColor> VertexColorsByPoint;
-	VertexColorsByPoint.Init(FColor::Black, Data.VertexColors.Num());
-	if (Data.bHasVertexColors)
+void UPSKFactory::BuildImportData(PSKReader& Data, const UPSKImportOptions* Options, FSkeletalMeshImportData& SkeletalMeshImportData, FActorXImportReport* Report)
+{
+	if (Report)
 	{
-		for (auto i = 0; i < Data.Wedges.Num(); i++)
-		{
-			auto FixedColor = Data.VertexColors[i];
-			Swap(FixedColor.R, FixedColor.B);
-			VertexColorsByPoint[Data.Wedges[i].PointIndex] = FixedColor;
-		}
+		Report->AddCount(TEXT("Points"), Data.Vertices.Num());
+		Report->AddCount(TEXT("Wedges"), Data.Wedges.Num());
+		Report->AddCount(TEXT("Faces"), Data.Faces.Num());
+		Report->AddCount(TEXT("Bones"), Data.Bones.Num());
+		Report->AddCount(TEXT("Influences"), Data.Influences.Num());
+		Report->AddCount(TEXT("ParseCacheHit"), Data.bFromCache ? 1 : 0);
 	}
-	
-	FSkeletalMeshImportData SkeletalMeshImportData;
 
-	for (auto i = 0; i < Data.Normals.Num(); i++)
+	FActorXImportReport::FPhase Phase(Report, TEXT("Convert"));
+
+	const auto VertexColorsByPoint = FActorXUtils::GetVertexColorsByPoint(Data);
+
+	const auto NumPoints = Data.Vertices.Num();
+	SkeletalMeshImportData.Points = MoveTemp(Data.Vertices);
+	SkeletalMeshImportData.PointToRawMap.SetNumUninitialized(NumPoints);
+	for (auto i = 0; i < NumPoints; i++)
 	{
-		Data.Normals[i].Y = -Data.Normals[i].Y; // MIRROR_MESH
+		SkeletalMeshImportData.PointToRawMap[i] = i;
 	}
 
-	for (auto Vertex : Data.Vertices)
+	// Corners making the same vertex share one wedge, so the build doesn't have to find them again
+	TArray<int32> CornerWedges;
+	TArray<int32> SourceWedges;
+	if (Options->bWeldWedges)
 	{
-		auto FixedVertex = Vertex;
-		FixedVertex.Y = -FixedVertex.Y; // MIRROR_MESH
-		SkeletalMeshImportData.Points.Add(FixedVertex);
-		SkeletalMeshImportData.PointToRawMap.Add(SkeletalMeshImportData.Points.Num()-1);
+		FActorXWedgeWelding::Weld(Data, Options->WeldUVTolerance, CornerWedges, SourceWedges);
 	}
-	
-	auto WindingOrder = {2, 1, 0};
-	for (const auto PskFace : Data.Faces)
+	else
+	{
+		FActorXWedgeWelding::MapCorners(Data, CornerWedges, SourceWedges);
+	}
+
+	if (Report)
 	{
-		SkeletalMeshImportData::FTriangle Face;
+		Report->AddCount(TEXT("WeldedWedges"), SourceWedges.Num());
+	}
+
+	const auto NumFaces = Data.Faces.Num();
+
+	// Faces are handed over section by section in the order the vertex cache likes, FaceOrder holds the file face at every position
+	TArray<int32> FaceOrder;
+	if (Options->bOptimizeVertexCache)
+	{
+		TArray<int32> Sections;
+		Sections.SetNumUninitialized(NumFaces);
+		for (auto FaceIndex = 0; FaceIndex < NumFaces; FaceIndex++)
+		{
+			Sections[FaceIndex] = static_cast<uint8>(Data.Faces[FaceIndex].MatIndex);
+		}
+
+		FActorXUtils::OptimizeFaceOrder(CornerWedges, Sections, FaceOrder, Report);
+	}
+
+	// Every output wedge and face is written at a known index, so both are filled in parallel
+	SkeletalMeshImportData.Wedges.SetNum(SourceWedges.Num());
+	ParallelFor(SourceWedges.Num(), [&](int32 ImportWedgeIndex)
+	{
+		const auto WedgeIndex = SourceWedges[ImportWedgeIndex];
+		const auto& PskWedge = Data.Wedges[WedgeIndex];
+
+		auto& Wedge = SkeletalMeshImportData.Wedges[ImportWedgeIndex];
+		Wedge.MatIndex = PskWedge.MatIndex;
+		Wedge.VertexIndex = PskWedge.PointIndex;
+		Wedge.Color = Data.bHasVertexColors ? VertexColorsByPoint[PskWedge.PointIndex] : FColor::Black;
+		Wedge.UVs[0] = FVector2f(PskWedge.U, PskWedge.V);
+		for (auto UVIdx = 0; UVIdx < Data.ExtraUVs.Num(); UVIdx++)
+		{
+			Wedge.UVs[UVIdx+1] = Data.ExtraUVs[UVIdx][WedgeIndex];
+		}
+	}, FActorXUtils::GetConversionFlags());
+
+	SkeletalMeshImportData.Faces.SetNum(NumFaces);
+	ParallelFor(NumFaces, [&](int32 ImportFaceIndex)
+	{
+		const auto FaceIndex = FaceOrder.IsEmpty() ? ImportFaceIndex : FaceOrder[ImportFaceIndex];
+		const auto& PskFace = Data.Faces[FaceIndex];
+		auto& Face = SkeletalMeshImportData.Faces[ImportFaceIndex];
 		Face.MatIndex = PskFace.MatIndex;
 		Face.SmoothingGroups = 1;
 		Face.AuxMatIndex = 0;
 
-		for (auto VertexIndex : WindingOrder)
+		for (auto VertexIndex = 0; VertexIndex < 3; VertexIndex++)
 		{
-			const auto WedgeIndex = PskFace.WedgeIndex[VertexIndex];
-			const auto PskWedge = Data.Wedges[WedgeIndex];
-			
-			SkeletalMeshImportData::FVertex Wedge;
-			Wedge.MatIndex = PskWedge.MatIndex;
-			Wedge.VertexIndex = PskWedge.PointIndex;
-			Wedge.Color = Data.bHasVertexColors ? VertexColorsByPoint[PskWedge.PointIndex] : FColor::Black;
-			Wedge.UVs[0] = FVector2f(PskWedge.U, PskWedge.V);
-			for (auto UVIdx = 0; UVIdx < Data.ExtraUVs.Num(); UVIdx++)
-			{
-				auto UV =  Data.ExtraUVs[UVIdx][PskFace.WedgeIndex[VertexIndex]];
-				Wedge.UVs[UVIdx+1] = UV;
-			}
-			
-			Face.WedgeIndex[VertexIndex] = SkeletalMeshImportData.Wedges.Add(Wedge);
+			const auto& PskWedge = Data.Wedges[PskFace.WedgeIndex[VertexIndex]];
+
+			Face.WedgeIndex[VertexIndex] = CornerWedges[FaceIndex * 3 + VertexIndex];
 			Face.TangentZ[VertexIndex] = Data.bHasVertexNormals ? Data.Normals[PskWedge.PointIndex] : FVector3f::ZeroVector;
 			Face.TangentY[VertexIndex] = FVector3f::ZeroVector;
 			Face.TangentX[VertexIndex] = FVector3f::ZeroVector;
 		}
-		Swap(Face.WedgeIndex[0], Face.WedgeIndex[2]);
-		Swap(Face.TangentZ[0], Face.TangentZ[2]);
+	}, FActorXUtils::GetConversionFlags());
 
-		SkeletalMeshImportData.Faces.Add(Face);
-	}
+	// The UV set count goes with the extra UVs released below
+	SkeletalMeshImportData.NumTexCoords = 1 + Data.ExtraUVs.Num();
 
-	TArray<FString> AddedBoneNames;
-	for (auto i = 0; i < Data.Bones.Num(); i++)
-	{
-		SkeletalMeshImportData::FBone Bone;
-		Bone.Name = Data.Bones[i].Name;
-		if (AddedBoneNames.Contains(Bone.Name)) continue;
-		AddedBoneNames.Add(Bone.Name);
-		
-		Bone.NumChildren = Data.Bones[i].NumChildren;
-		
-		Bone.ParentIndex = (i > 0) ? Data.Bones[i].ParentIndex : INDEX_NONE;
-		auto PskBonePos = Data.Bones[i].BonePos;
-		
-		FTransform3f PskTransform;
-		PskTransform.SetLocation(FVector3f(PskBonePos.Position.X, -PskBonePos.Position.Y, PskBonePos.Position.Z));
-		PskTransform.SetRotation(FQuat4f(-PskBonePos.Orientation.X, PskBonePos.Orientation.Y, -PskBonePos.Orientation.Z, (Bone.ParentIndex == INDEX_NONE) ? PskBonePos.Orientation.W : -PskBonePos.Orientation.W).GetNormalized());
-		
-		SkeletalMeshImportData::FJointPos BonePos;
-		BonePos.Transform = PskTransform;
-		BonePos.Length = PskBonePos.Length;
-		BonePos.XSize = PskBonePos.XSize;
-		BonePos.YSize = PskBonePos.YSize;
-		BonePos.ZSize = PskBonePos.ZSize;
+	// Nothing reads the per wedge data of the reader after this point
+	Data.Wedges.Empty();
+	Data.Faces.Empty();
+	Data.Normals.Empty();
+	Data.VertexColors.Empty();
+	Data.ExtraUVs.Empty();
+	VertexColorsByPoint.Empty();
 
-		Bone.BonePos = BonePos;
-		SkeletalMeshImportData.RefBonesBinary.Add(Bone);
-		AddedBoneNames.Add(Bone.Name);
-	}
+	// Duplicate bones are dropped, so everything pointing at a file bone goes through the table's remap
+	FActorXBoneTable BoneTable;
+	BoneTable.Build(Data.Bones);
 
-	for (auto PskInfluence : Data.Influences)
+	if (Report)
 	{
-		SkeletalMeshImportData::FRawBoneInfluence Influence;
-		Influence.BoneIndex = PskInfluence.BoneIdx;
-		Influence.VertexIndex = PskInfluence.PointIdx;
-		Influence.Weight = PskInfluence.Weight;
-		SkeletalMeshImportData.Influences.Add(Influence);
+		Report->AddCount(TEXT("DuplicateBones"), BoneTable.NumDuplicates);
+		Report->AddCount(TEXT("ReparentedBones"), BoneTable.NumReparented);
+		Report->AddCount(TEXT("SkeletonDepth"), BoneTable.MaxDepth);
 	}
 
-	for (auto PskMaterial : Data.Materials)
+	SkeletalMeshImportData.RefBonesBinary.SetNum(BoneTable.Bones.Num());
+	ParallelFor(BoneTable.Bones.Num(), [&](int32 BoneIndex)
 	{
-		SkeletalMeshImportData::FMaterial Material;
-		Material.MaterialImportName = PskMaterial.MaterialName;
+		const auto& TableBone = BoneTable.Bones[BoneIndex];
+		const auto& PskBone = Data.Bones[TableBone.FileIndex];
+		const auto& PskBonePos = PskBone.BonePos;
+
+		// Names keep the file's casing, which the FName may not
+		auto& Bone = SkeletalMeshImportData.RefBonesBinary[BoneIndex];
+		Bone.Name = PskBone.Name;
+		Bone.NumChildren = TableBone.NumChildren;
+		Bone.ParentIndex = TableBone.ParentIndex;
 
-		if (SettingsImporter->bCreateMaterials)
+		FTransform3f PskTransform;
+		PskTransform.SetLocation(FActorXConversion::MirrorVector(PskBonePos.Position));
+		PskTransform.SetRotation(FActorXConversion::ConvertRotation(PskBonePos.Orientation, Bone.ParentIndex == INDEX_NONE));
+
+		Bone.BonePos.Transform = PskTransform;
+		Bone.BonePos.Length = PskBonePos.Length;
+		Bone.BonePos.XSize = PskBonePos.XSize;
+		Bone.BonePos.YSize = PskBonePos.YSize;
+		Bone.BonePos.ZSize = PskBonePos.ZSize;
+	}, FActorXUtils::GetConversionFlags());
+
+	ParallelFor(Data.Influences.Num(), [&](int32 i)
+	{
+		auto& Influence = Data.Influences[i];
+		Influence.BoneIdx = BoneTable.Remap(Influence.BoneIdx);
+
+		// Influences on bones outside the file have nothing to bind to, the skin weights drop them like points outside the mesh
+		if (Influence.BoneIdx == INDEX_NONE)
 		{
-			auto MaterialAdd = FActorXUtils::LocalFindOrCreate<UMaterial>(UMaterial::StaticClass(), Parent, PskMaterial.MaterialName, Flags);
-			Material.Material = MaterialAdd;
+			Influence.PointIdx = INDEX_NONE;
 		}
-		else
+	}, FActorXUtils::GetConversionFlags());
+
+	// Influences reach the build pruned, normalised and sorted by point, so it has nothing left to fix up
+	FActorXSkinWeights SkinWeights;
+	SkinWeights.Build(Data.Influences, NumPoints, Options->MaxBoneInfluences, Options->BoneInfluenceThreshold, FActorXUtils::GetConversionFlags());
+	Data.Influences.Empty();
+
+	if (Report)
+	{
+		Report->AddCount(TEXT("PrunedInfluences"), SkinWeights.NumPruned);
+		Report->AddCount(TEXT("MaxPointInfluences"), SkinWeights.MaxPointInfluences);
+		Report->AddCount(TEXT("UnweightedPoints"), SkinWeights.NumUnweightedPoints);
+	}
+
+	SkeletalMeshImportData.Influences.SetNum(SkinWeights.NumInfluences());
+	ParallelFor(NumPoints, [&](int32 Point)
+	{
+		const auto Bones = SkinWeights.GetBoneIndices(Point);
+		const auto Weights = SkinWeights.GetWeights(Point);
+		for (auto i = 0; i < Bones.Num(); i++)
 		{
-			Material.Material = UMaterial::GetDefaultMaterial(MD_Surface);
+			auto& Influence = SkeletalMeshImportData.Influences[SkinWeights.Offsets[Point] + i];
+			Influence.BoneIndex = Bones[i];
+			Influence.VertexIndex = Point;
+			Influence.Weight = Weights[i];
 		}
+	}, FActorXUtils::GetConversionFlags());
 
+	SkeletalMeshImportData.Materials.Reserve(Data.Materials.Num());
+	for (const auto& PskMaterial : Data.Materials)
+	{
+		SkeletalMeshImportData::FMaterial Material;
+		Material.MaterialImportName = PskMaterial.MaterialName;
 		SkeletalMeshImportData.Materials.Add(Material);
 	}
 	
@@ -202,25 +343,69 @@ UObject* UPSKFactory::FactoryCreateFile(UClass* Class, UObject* Parent, FName Na
 	SkeletalMeshImportData.bHasNormals = Data.bHasVertexNormals;
 	SkeletalMeshImportData.bHasTangents = false;
 	SkeletalMeshImportData.bHasVertexColors = true;
-	SkeletalMeshImportData.NumTexCoords = 1 + Data.ExtraUVs.Num(); 
 	SkeletalMeshImportData.bUseT0AsRefPose = false;
-	
-	const auto Skeleton = FActorXUtils::LocalCreate<USkeleton>(USkeleton::StaticClass(), Parent,  Name.ToString().Append("_Skeleton"), Flags);
+}
+
+USkeletalMesh* UPSKFactory::CreateSkeletalMesh(PSKReader& Data, UObject* Parent, FName Name, EObjectFlags Flags, const UPSKImportOptions* Options, FActorXImportReport* Report)
+{
+	FSkeletalMeshImportData SkeletalMeshImportData;
+	TMap<FName, uint64> PieceHashes;
+	BuildImportData(Data, Options, SkeletalMeshImportData, PieceHashes, Report);
+	return CreateSkeletalMesh(Data, SkeletalMeshImportData, PieceHashes, Parent, Name, Flags, Options, Report);
+}
 
+USkeletalMesh* UPSKFactory::CreateSkeletalMesh(PSKReader& Data, FSkeletalMeshImportData& SkeletalMeshImportData, const TMap<FName, uint64>& PieceHashes, UObject* Parent, FName Name, EObjectFlags Flags,
+	const UPSKImportOptions* Options, FActorXImportReport* Report, USkeleton* ExistingSkeleton)
+{
+	// Only the material objects are missing from the import data, the rest was built by BuildImportData
+	FActorXImportReport::FPhase Phase(Report, TEXT("Materials"));
+	for (auto i = 0; i < Data.Materials.Num(); i++)
+	{
+		SkeletalMeshImportData.Materials[i].Material = GetImportMaterial(Data.Materials[i], Parent, Flags, Options);
+	}
+
+	Phase.Next(TEXT("ProcessSkeleton"));
 	FReferenceSkeleton RefSkeleton;
-	auto SkeletalDepth = 0;
-	ProcessSkeleton(SkeletalMeshImportData, Skeleton, RefSkeleton, SkeletalDepth);
-
-	TArray<FVector3f> LODPoints;
-	TArray<SkeletalMeshImportData::FMeshWedge> LODWedges;
-	TArray<SkeletalMeshImportData::FMeshFace> LODFaces;
-	TArray<SkeletalMeshImportData::FVertInfluence> LODInfluences;
-	TArray<int32> LODPointToRawMap;
-	SkeletalMeshImportData.CopyLODImportData(LODPoints, LODWedges, LODFaces, LODInfluences, LODPointToRawMap);
-
-	FSkeletalMeshLODModel LODModel;
-	LODModel.NumTexCoords = FMath::Max<uint32>(1, SkeletalMeshImportData.NumTexCoords);
-	
+	ProcessSkeleton(SkeletalMeshImportData, nullptr, RefSkeleton);
+
+	// A rebuilt mesh stays on its skeleton unless its bones no longer fit it
+	auto SkeletonMatch = EActorXSkeletonMatch::None;
+	USkeleton* Skeleton = nullptr;
+	if (ExistingSkeleton)
+	{
+		SkeletonMatch = FActorXSkeletonIndex::Match(RefSkeleton, ExistingSkeleton->GetReferenceSkeleton());
+		if (SkeletonMatch != EActorXSkeletonMatch::None)
+		{
+			Skeleton = ExistingSkeleton;
+		}
+		else
+		{
+			UE_LOG(LogActorXImport, Warning, TEXT("The bones of %s no longer match its skeleton %s"), *Name.ToString(), *ExistingSkeleton->GetPathName());
+		}
+	}
+
+	// Meshes with the same bones share a skeleton, a new one is only created when no existing one fits
+	if (!Skeleton && Options->bReuseSkeleton)
+	{
+		Skeleton = FActorXSkeletonIndex::FindCompatible(RefSkeleton, SkeletonMatch);
+	}
+
+	const auto bNewSkeleton = Skeleton == nullptr;
+	if (bNewSkeleton)
+	{
+		Skeleton = FActorXUtils::LocalCreate<USkeleton>(USkeleton::StaticClass(), Parent,  Name.ToString().Append("_Skeleton"), Flags);
+	}
+	else
+	{
+		UE_LOG(LogActorXImport, Log, TEXT("Binding %s to the existing skeleton %s"), *Name.ToString(), *Skeleton->GetPathName());
+	}
+
+	if (Report)
+	{
+		Report->AddCount(TEXT("ReusedSkeleton"), bNewSkeleton ? 0 : 1);
+	}
+
+	Phase.Next(TEXT("SaveImportData"));
 	const auto SkeletalMesh = FActorXUtils::LocalCreate<USkeletalMesh>(USkeletalMesh::StaticClass(), Parent, Name.ToString(), Flags);
 	SkeletalMesh->PreEditChange(nullptr);
 	SkeletalMesh->InvalidateDeriveDataCacheGUID();
@@ -245,14 +430,23 @@ UObject* UPSKFactory::FactoryCreateFile(UClass* Class, UObject* Parent, FName Na
 	SkeletalMesh->CalculateInvRefMatrices();
 
 	SkeletalMesh->SaveLODImportedData(0, SkeletalMeshImportData);
+
+	// The mesh builder reads the copy saved with the mesh, only the materials are still needed here
+	SkeletalMeshImportData.Points.Empty();
+	SkeletalMeshImportData.PointToRawMap.Empty();
+	SkeletalMeshImportData.Wedges.Empty();
+	SkeletalMeshImportData.Faces.Empty();
+	SkeletalMeshImportData.Influences.Empty();
+
 	FSkeletalMeshBuildSettings BuildOptions;
 	BuildOptions.bRemoveDegenerates = false;
 	BuildOptions.bRecomputeNormals = !Data.bHasVertexNormals;
 	BuildOptions.bRecomputeTangents = true;
 	BuildOptions.bUseMikkTSpace = true;
 	SkeletalMesh->GetLODInfo(0)->BuildSettings = BuildOptions;
-	SkeletalMesh->SetImportedBounds(FBoxSphereBounds(FBoxSphereBounds3f(FBox3f(SkeletalMeshImportData.Points))));
+	SkeletalMesh->SetImportedBounds(FBoxSphereBounds(FBoxSphereBounds3f(Data.Bounds)));
 
+	Phase.Next(TEXT("BuildSkeletalMesh"));
 	auto& MeshBuilderModule = IMeshBuilderModule::GetForRunningPlatform();
 	const FSkeletalMeshBuildParameters SkeletalMeshBuildParameters(SkeletalMesh, GetTargetPlatformManagerRef().GetRunningTargetPlatform(), 0, false);
 	if (!MeshBuilderModule.BuildSkeletalMesh(SkeletalMeshBuildParameters))
@@ -261,7 +455,15 @@ UObject* UPSKFactory::FactoryCreateFile(UClass* Class, UObject* Parent, FName Na
 		return nullptr;
 	}
 
-	for (auto Material : SkeletalMeshImportData.Materials)
+	if (Options->bOptimizeVertexCache)
+	{
+		FActorXUtils::AddBuiltACMR(ImportedResource->LODModels[0].IndexBuffer, Report);
+	}
+
+	Phase.Next(TEXT("Finalize"));
+
+	SkeletalMesh->GetMaterials().Reserve(SkeletalMeshImportData.Materials.Num());
+	for (const auto& Material : SkeletalMeshImportData.Materials)
 	{
 		FSkeletalMaterial SkelMat(Material.Material.Get());
 		SkelMat.MaterialSlotName = FName(Material.MaterialImportName);
@@ -270,74 +472,169 @@ UObject* UPSKFactory::FactoryCreateFile(UClass* Class, UObject* Parent, FName Na
 	}
 
 	// Assign sockets to the model
-	for (auto Socket : Data.Sockets)
-	{
-		USkeletalMeshSocket* NewSocket = NewObject<USkeletalMeshSocket>(SkeletalMesh);
-		NewSocket->SocketName = FName(Socket.SocketName);
-		NewSocket->BoneName = FName(Socket.BoneName);
-		NewSocket->RelativeLocation = Socket.RelativeLocation;
-		NewSocket->RelativeRotation = Socket.RelativeRotation;
-		NewSocket->RelativeScale = Socket.RelativeScale;
+	AddSockets(SkeletalMesh, Data);
 
-		SkeletalMesh->AddSocket(NewSocket);
-	}
+	const auto ImportData = UActorXAssetImportData::GetOrCreate(SkeletalMesh, SkeletalMesh->GetAssetImportData());
+	ImportData->SetImported(Data.GetFileName(), Options, PieceHashes);
+	SkeletalMesh->SetAssetImportData(ImportData);
 
 	// morphdata here
 	
 	SkeletalMesh->PostEditChange();
 	
 	SkeletalMesh->SetSkeleton(Skeleton);
-	Skeleton->MergeAllBonesToBoneTree(SkeletalMesh);
-	
+
 	FAssetRegistryModule::AssetCreated(SkeletalMesh);
 	SkeletalMesh->MarkPackageDirty();
 
-	Skeleton->PostEditChange();
-	FAssetRegistryModule::AssetCreated(Skeleton);
-	Skeleton->MarkPackageDirty();
-
-	if (!bImportAll)
+	// A skeleton the mesh fits in is left as it is, only new skeletons and ones the mesh adds bones to take its bone tree
+	if (bNewSkeleton || SkeletonMatch == EActorXSkeletonMatch::Superset)
 	{
-		SettingsImporter->bInitialized = false;
+		Skeleton->Modify();
+		Skeleton->MergeAllBonesToBoneTree(SkeletalMesh);
+		Skeleton->PostEditChange();
+		Skeleton->MarkPackageDirty();
+
+		// A new skeleton is tagged when it is registered below, an extended one keeps its old bones in the registry until it is saved
+		if (!bNewSkeleton)
+		{
+			FActorXSkeletonIndex::UpdateTags(Skeleton);
+		}
 	}
 
-	FGlobalComponentReregisterContext RecreateComponents;
+	if (bNewSkeleton)
+	{
+		FAssetRegistryModule::AssetCreated(Skeleton);
+	}
 
 	return SkeletalMesh;
 }
 
-void UPSKFactory::ProcessSkeleton(const FSkeletalMeshImportData& ImportData, const USkeleton* Skeleton, FReferenceSkeleton& OutRefSkeleton, int& OutSkeletalDepth)
+bool UPSKFactory::CanReimport(UObject* Obj, TArray<FString>& OutFilenames)
+{
+	const auto SkeletalMesh = Cast<USkeletalMesh>(Obj);
+	const auto ImportData = SkeletalMesh ? Cast<UActorXAssetImportData>(SkeletalMesh->GetAssetImportData()) : nullptr;
+	if (!ImportData)
+	{
+		return false;
+	}
+
+	ImportData->ExtractFilenames(OutFilenames);
+	return true;
+}
+
+void UPSKFactory::SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths)
+{
+	const auto SkeletalMesh = Cast<USkeletalMesh>(Obj);
+	const auto ImportData = SkeletalMesh ? Cast<UActorXAssetImportData>(SkeletalMesh->GetAssetImportData()) : nullptr;
+	if (ImportData && ensure(NewReimportPaths.Num() == 1))
+	{
+		ImportData->UpdateFilenameOnly(NewReimportPaths[0]);
+	}
+}
+
+EReimportResult::Type UPSKFactory::Reimport(UObject* Obj)
+{
+	const auto SkeletalMesh = Cast<USkeletalMesh>(Obj);
+	const auto ImportData = SkeletalMesh ? Cast<UActorXAssetImportData>(SkeletalMesh->GetAssetImportData()) : nullptr;
+	if (!ImportData)
+	{
+		return EReimportResult::Failed;
+	}
+
+	const auto Filename = ImportData->GetFirstFilename();
+	const auto Options = ImportData->MakePSKOptions();
+
+	FActorXImportReport Report(Filename);
+	auto Data = PSKReader(Filename, Options->bLoadProperties);
+	auto bRead = false;
+	{
+		FActorXImportReport::FPhase Phase(&Report, TEXT("Read"));
+		bRead = Data.ReadConverted();
+	}
+	Report.AddChunks(Data.ChunkStats);
+
+	if (!bRead)
+	{
+		UE_LOG(LogActorXImport, Error, TEXT("Failed to reimport %s from %s"), *SkeletalMesh->GetPathName(), *Filename);
+		Report.Save();
+		return EReimportResult::Failed;
+	}
+
+	const auto NewHashes = FActorXUtils::PrepareMesh(Data, Options, &Report);
+	const auto ChangedPieces = ImportData->GetChangedPieces(NewHashes);
+	Report.AddCount(TEXT("ChangedPieces"), ChangedPieces.Num());
+
+	const auto bRebuild = UActorXAssetImportData::NeedsRebuild(ChangedPieces, { ActorXPieces::Geometry, ActorXPieces::Skinning, ActorXPieces::Skeleton },
+		Data.Materials.Num(), SkeletalMesh->GetMaterials().Num());
+
+	if (bRebuild)
+	{
+		UE_LOG(LogActorXImport, Log, TEXT("Rebuilding %s, its geometry, skinning or skeleton changed"), *SkeletalMesh->GetPathName());
+
+		// The reader was converted and hashed above, the rebuild goes on from there
+		FSkeletalMeshImportData SkeletalMeshImportData;
+		BuildImportData(Data, Options, SkeletalMeshImportData, &Report);
+		const auto Rebuilt = CreateSkeletalMesh(Data, SkeletalMeshImportData, NewHashes, SkeletalMesh->GetOutermost(), SkeletalMesh->GetFName(),
+			RF_Public | RF_Standalone | RF_Transactional, Options, &Report, SkeletalMesh->GetSkeleton());
+		if (!Rebuilt)
+		{
+			Report.Save();
+			return EReimportResult::Failed;
+		}
+
+		Report.SetAsset(Rebuilt);
+	}
+	else
+	{
+		FActorXImportReport::FPhase Phase(&Report, TEXT("UpdatePieces"));
+		SkeletalMesh->PreEditChange(nullptr);
+
+		if (ChangedPieces.Contains(ActorXPieces::Materials))
+		{
+			auto& Materials = SkeletalMesh->GetMaterials();
+			for (auto i = 0; i < Data.Materials.Num(); i++)
+			{
+				const auto& PskMaterial = Data.Materials[i];
+				Materials[i].MaterialInterface = GetImportMaterial(PskMaterial, SkeletalMesh->GetOutermost(), RF_Public | RF_Standalone | RF_Transactional, Options);
+				Materials[i].MaterialSlotName = FName(PskMaterial.MaterialName);
+				Materials[i].ImportedMaterialSlotName = FName(PskMaterial.MaterialName);
+			}
+		}
+
+		if (ChangedPieces.Contains(ActorXPieces::Sockets))
+		{
+			SkeletalMesh->GetMeshOnlySocketList().Empty();
+			AddSockets(SkeletalMesh, Data);
+		}
+
+		ImportData->Update(Filename);
+		ImportData->PieceHashes = NewHashes;
+
+		SkeletalMesh->PostEditChange();
+		SkeletalMesh->MarkPackageDirty();
+		Report.SetAsset(SkeletalMesh);
+	}
+
+	Report.Save();
+	return EReimportResult::Succeeded;
+}
+
+int32 UPSKFactory::GetPriority() const
+{
+	return ImportPriority;
+}
+
+void UPSKFactory::ProcessSkeleton(const FSkeletalMeshImportData& ImportData, const USkeleton* Skeleton, FReferenceSkeleton& OutRefSkeleton)
 {
-	const auto RefBonesBinary = ImportData.RefBonesBinary;
+	const auto& RefBonesBinary = ImportData.RefBonesBinary;
 	OutRefSkeleton.Empty();
 	
 	FReferenceSkeletonModifier RefSkeletonModifier(OutRefSkeleton, Skeleton);
 	
-	for (const auto Bone : RefBonesBinary)
+	for (const auto& Bone : RefBonesBinary)
 	{
 		const FMeshBoneInfo BoneInfo(FName(*Bone.Name), Bone.Name, Bone.ParentIndex);
 		RefSkeletonModifier.Add(BoneInfo, FTransform(Bone.BonePos.Transform));
 	}
-
-    OutSkeletalDepth = 0;
-
-    TArray<int> SkeletalDepths;
-    SkeletalDepths.Empty(ImportData.RefBonesBinary.Num());
-    SkeletalDepths.AddZeroed(ImportData.RefBonesBinary.Num());
-    for (auto b = 0; b < OutRefSkeleton.GetNum(); b++)
-    {
-        const auto Parent = OutRefSkeleton.GetParentIndex(b);
-        auto Depth  = 1.0f;
-
-        SkeletalDepths[b] = 1.0f;
-        if (Parent != INDEX_NONE)
-        {
-            Depth += SkeletalDepths[Parent];
-        }
-        if (OutSkeletalDepth < Depth)
-        {
-            OutSkeletalDepth = Depth;
-        }
-        SkeletalDepths[b] = Depth;
-    }
 }
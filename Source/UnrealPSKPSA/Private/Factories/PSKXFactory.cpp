@@ -1,8 +1,12 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Factories/PSKXFactory.h"
+#include "UnrealPSKPSA.h"
 #include "Readers/PSKReader.h"
-#include "RawMesh.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#include "StaticMeshResources.h"
+#include "Async/ParallelFor.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Materials/MaterialInstanceConstant.h"
 #include "Editor/UnrealEd/Classes/Factories/MaterialInstanceConstantFactoryNew.h"
@@ -11,10 +15,26 @@
 #include "AssetToolsModule.h"
 #include "ComponentReregisterContext.h"
 #include "IAssetTools.h"
+#include "Misc/App.h"
+#include "Utils/ActorXAssetImportData.h"
 #include "Utils/ActorXUtils.h"
+#include "Utils/ActorXWedgeWelding.h"
+#include "Utils/ActorXImportReport.h"
 #include "Widgets/PSKImportOptions.h"
 #include "Widgets/SPSKImportOption.h"
 
+static FStaticMaterial GetImportMaterial(const VMaterial& PskMaterial, UObject* Parent, EObjectFlags Flags, const UPSKImportOptions* Options)
+{
+	if (Options->bCreateMaterials)
+	{
+		auto MaterialAdd = FActorXUtils::LocalFindOrCreate<UMaterial>(UMaterial::StaticClass(), Parent, PskMaterial.MaterialName, Flags);
+		return FStaticMaterial(MaterialAdd, PskMaterial.MaterialName, PskMaterial.MaterialName);
+	}
+
+	// Slot names match the polygon groups of the mesh description
+	return FStaticMaterial(nullptr, PskMaterial.MaterialName, PskMaterial.MaterialName);
+}
+
 /* UTextAssetFactory structors
  *****************************************************************************/
 
@@ -42,8 +62,40 @@ UObject* UPSKXFactory::FactoryCreateFile(UClass* Class, UObject* Parent, FName N
 	}
 	SlowTask.EnterProgressFrame(0);
 
-	// picker
-	if (SettingsImporter->bInitialized == false)
+	// Cancel the import
+	if (!ConfigureOptions())
+	{
+		return nullptr;
+	}
+
+	FActorXImportReport Report(Filename);
+	auto Data = PSKReader(Filename);
+	auto bRead = false;
+	{
+		FActorXImportReport::FPhase Phase(&Report, TEXT("Read"));
+		bRead = Data.ReadConverted();
+	}
+	Report.AddChunks(Data.ChunkStats);
+
+	// Failed imports are reported too, they have no asset
+	const auto StaticMesh = bRead ? CreateStaticMesh(Data, Parent, Name, Flags, SettingsImporter, &Report) : nullptr;
+	Report.SetAsset(StaticMesh);
+	Report.Save();
+
+	if (!bImportAll)
+	{
+		SettingsImporter->bInitialized = false;
+	}
+
+	FGlobalComponentReregisterContext RecreateComponents;
+	
+	return StaticMesh;
+}
+
+bool UPSKXFactory::ConfigureOptions()
+{
+	// picker, automated and unattended imports use the options as they are
+	if (SettingsImporter->bInitialized == false && !IsAutomatedImport() && !FApp::IsUnattended())
 	{
 		TSharedPtr<SPSKImportOption> ImportOptionsWindow;
 		TSharedPtr<SWindow> ParentWindow;
@@ -63,77 +115,174 @@ UObject* UPSKXFactory::FactoryCreateFile(UClass* Class, UObject* Parent, FName N
 		SettingsImporter->bInitialized = true;
 	}
 
-	// Cancel the import
-	if (bCancel)
+	return !bCancel;
+}
+
+void UPSKXFactory::BuildMeshDescription(PSKReader& Data, const UPSKImportOptions* Options, FMeshDescription& MeshDescription, TMap<FName, uint64>& OutPieceHashes, FActorXImportReport* Report)
+{
 	{
-		return nullptr;
+		FActorXImportReport::FPhase Phase(Report, TEXT("Convert"));
+		OutPieceHashes = FActorXUtils::PrepareMesh(Data, Options, Report);
 	}
 
-	auto Data = PSKReader(Filename);
-	if (!Data.Read()) return nullptr;
-	
-	TArray<FColor> VertexColorsByPoint;
-	VertexColorsByPoint.Init(FColor::Black, Data.VertexColors.Num());
-	if (Data.bHasVertexColors)
+	BuildMeshDescription(Data, Options, MeshDescription, Report);
+}
+
+void UPSKXFactory::BuildMeshDescription(PSKReader& Data, const UPSKImportOptions* Options, FMeshDescription& MeshDescription, FActorXImportReport* Report)
+{
+	if (Report)
 	{
-		for (auto i = 0; i < Data.Wedges.Num(); i++)
+		Report->AddCount(TEXT("Points"), Data.Vertices.Num());
+		Report->AddCount(TEXT("Wedges"), Data.Wedges.Num());
+		Report->AddCount(TEXT("Faces"), Data.Faces.Num());
+		Report->AddCount(TEXT("UVSets"), 1 + Data.ExtraUVs.Num());
+		Report->AddCount(TEXT("ParseCacheHit"), Data.bFromCache ? 1 : 0);
+	}
+
+	FActorXImportReport::FPhase Phase(Report, TEXT("Convert"));
+
+	const auto VertexColorsByPoint = FActorXUtils::GetVertexColorsByPoint(Data);
+
+	FStaticMeshAttributes Attributes(MeshDescription);
+	Attributes.Register();
+
+	const auto NumPoints = Data.Vertices.Num();
+	const auto NumUVs = 1 + Data.ExtraUVs.Num();
+
+	// Triangles using the same point twice are dropped, like the raw mesh conversion did
+	TArray<int32> KeptFaces;
+	KeptFaces.Reserve(Data.Faces.Num());
+	auto NumPolygonGroups = Data.Materials.Num();
+	for (auto FaceIndex = 0; FaceIndex < Data.Faces.Num(); FaceIndex++)
+	{
+		const auto& PskFace = Data.Faces[FaceIndex];
+		const auto Point0 = Data.Wedges[PskFace.WedgeIndex[0]].PointIndex;
+		const auto Point1 = Data.Wedges[PskFace.WedgeIndex[1]].PointIndex;
+		const auto Point2 = Data.Wedges[PskFace.WedgeIndex[2]].PointIndex;
+		if (Point0 == Point1 || Point1 == Point2 || Point2 == Point0)
 		{
-			auto FixedColor = Data.VertexColors[i];
-			Swap(FixedColor.R, FixedColor.B);
-			VertexColorsByPoint[Data.Wedges[i].PointIndex] = FixedColor;
+			continue;
 		}
+
+		KeptFaces.Add(FaceIndex);
+		NumPolygonGroups = FMath::Max(NumPolygonGroups, static_cast<uint8>(PskFace.MatIndex) + 1);
 	}
-	
-	auto RawMesh = FRawMesh();
-	for (auto Vertex : Data.Vertices)
+
+	// Corners making the same vertex share one vertex instance, so the build doesn't have to find them again
+	TArray<int32> CornerWedges;
+	TArray<int32> SourceWedges;
+	if (Options->bWeldWedges)
 	{
-		auto FixedVertex = Vertex;
-		FixedVertex.Y = -FixedVertex.Y; // MIRROR_MESH
-		RawMesh.VertexPositions.Add(FixedVertex);
+		FActorXWedgeWelding::Weld(Data, Options->WeldUVTolerance, KeptFaces, CornerWedges, SourceWedges);
+	}
+	else
+	{
+		FActorXWedgeWelding::MapCorners(Data, KeptFaces, CornerWedges, SourceWedges);
 	}
 
-	auto WindingOrder = {2, 1, 0};
-	for (const auto PskFace : Data.Faces)
+	if (Report)
 	{
-		RawMesh.FaceMaterialIndices.Add(PskFace.MatIndex);
-		RawMesh.FaceSmoothingMasks.Add(1);
+		Report->AddCount(TEXT("WeldedWedges"), SourceWedges.Num());
+	}
 
-		for (auto VertexIndex : WindingOrder)
+	// Triangles are created section by section in the order the vertex cache likes, FaceOrder holds the kept face at every position
+	TArray<int32> FaceOrder;
+	if (Options->bOptimizeVertexCache)
+	{
+		TArray<int32> Sections;
+		Sections.SetNumUninitialized(KeptFaces.Num());
+		for (auto KeptIndex = 0; KeptIndex < KeptFaces.Num(); KeptIndex++)
 		{
-			const auto WedgeIndex = PskFace.WedgeIndex[VertexIndex];
-			const auto PskWedge = Data.Wedges[WedgeIndex];
-
-			RawMesh.WedgeIndices.Add(PskWedge.PointIndex);
-			RawMesh.WedgeColors.Add(Data.bHasVertexColors ? VertexColorsByPoint[PskWedge.PointIndex] : FColor::Black);
-			RawMesh.WedgeTexCoords[0].Add(FVector2f(PskWedge.U, PskWedge.V));
-			for (auto UVIndex = 0; UVIndex < Data.ExtraUVs.Num(); UVIndex++)
-			{
-				auto UV =  Data.ExtraUVs[UVIndex][PskFace.WedgeIndex[VertexIndex]];
-				RawMesh.WedgeTexCoords[UVIndex+1].Add(UV);
-			}
-			
-			RawMesh.WedgeTangentZ.Add(Data.bHasVertexNormals ? Data.Normals[PskWedge.PointIndex] * FVector3f(1, -1, 1) : FVector3f::ZeroVector);
-			RawMesh.WedgeTangentY.Add(FVector3f::ZeroVector);
-			RawMesh.WedgeTangentX.Add(FVector3f::ZeroVector);
+			Sections[KeptIndex] = static_cast<uint8>(Data.Faces[KeptFaces[KeptIndex]].MatIndex);
 		}
+
+		FActorXUtils::OptimizeFaceOrder(CornerWedges, Sections, FaceOrder, Report);
 	}
 
-	const auto StaticMesh = CastChecked<UStaticMesh>(CreateOrOverwriteAsset(UStaticMesh::StaticClass(), Parent, Name, Flags));
-	
-	for (auto i = 0; i < Data.Materials.Num(); i++)
+	MeshDescription.ReserveNewVertices(NumPoints);
+	MeshDescription.ReserveNewVertexInstances(SourceWedges.Num());
+	MeshDescription.ReserveNewTriangles(KeptFaces.Num());
+	MeshDescription.ReserveNewPolygonGroups(NumPolygonGroups);
+
+	// Elements of a new description get consecutive ids, so they are created up front and their attributes filled in parallel
+	for (auto i = 0; i < NumPoints; i++)
 	{
-		auto PskMaterial = Data.Materials[i];
+		MeshDescription.CreateVertex();
+	}
 
-		if (SettingsImporter->bCreateMaterials)
-		{
-			auto MaterialAdd = FActorXUtils::LocalFindOrCreate<UMaterial>(UMaterial::StaticClass(), Parent, PskMaterial.MaterialName, Flags);
-			StaticMesh->GetStaticMaterials().Add(FStaticMaterial(MaterialAdd));
-		}
-		else
+	for (const auto WedgeIndex : SourceWedges)
+	{
+		MeshDescription.CreateVertexInstance(FVertexID(Data.Wedges[WedgeIndex].PointIndex));
+	}
+
+	const auto PolygonGroupSlotNames = Attributes.GetPolygonGroupMaterialSlotNames();
+	for (auto i = 0; i < NumPolygonGroups; i++)
+	{
+		const auto PolygonGroup = MeshDescription.CreatePolygonGroup();
+		PolygonGroupSlotNames[PolygonGroup] = i < Data.Materials.Num() ? FName(Data.Materials[i].MaterialName) : NAME_None;
+	}
+
+	const auto VertexPositions = Attributes.GetVertexPositions();
+	ParallelFor(NumPoints, [&](int32 PointIndex)
+	{
+		VertexPositions[FVertexID(PointIndex)] = Data.Vertices[PointIndex];
+	}, FActorXUtils::GetConversionFlags());
+
+	const auto InstanceNormals = Attributes.GetVertexInstanceNormals();
+	const auto InstanceColors = Attributes.GetVertexInstanceColors();
+	auto InstanceUVs = Attributes.GetVertexInstanceUVs();
+	InstanceUVs.SetNumChannels(NumUVs);
+
+	ParallelFor(SourceWedges.Num(), [&](int32 InstanceIndex)
+	{
+		const auto WedgeIndex = SourceWedges[InstanceIndex];
+		const auto& PskWedge = Data.Wedges[WedgeIndex];
+		const auto VertexInstance = FVertexInstanceID(InstanceIndex);
+
+		InstanceUVs.Set(VertexInstance, 0, FVector2f(PskWedge.U, PskWedge.V));
+		for (auto UVIndex = 0; UVIndex < Data.ExtraUVs.Num(); UVIndex++)
 		{
-			StaticMesh->GetStaticMaterials().Add(FStaticMaterial(nullptr, PskMaterial.MaterialName));
+			InstanceUVs.Set(VertexInstance, UVIndex + 1, Data.ExtraUVs[UVIndex][WedgeIndex]);
 		}
 
+		// Normals left at zero are recomputed by the build
+		InstanceNormals[VertexInstance] = Data.bHasVertexNormals ? Data.Normals[PskWedge.PointIndex] : FVector3f::ZeroVector;
+		InstanceColors[VertexInstance] = FVector4f(FLinearColor(Data.bHasVertexColors ? VertexColorsByPoint[PskWedge.PointIndex] : FColor::Black));
+	}, FActorXUtils::GetConversionFlags());
+
+	// Triangles update the edge and adjacency data, so they are the one part created in order
+	for (auto TriangleIndex = 0; TriangleIndex < KeptFaces.Num(); TriangleIndex++)
+	{
+		const auto KeptIndex = FaceOrder.IsEmpty() ? TriangleIndex : FaceOrder[TriangleIndex];
+		const FVertexInstanceID VertexInstances[3] = { FVertexInstanceID(CornerWedges[KeptIndex * 3]), FVertexInstanceID(CornerWedges[KeptIndex * 3 + 1]), FVertexInstanceID(CornerWedges[KeptIndex * 3 + 2]) };
+		MeshDescription.CreateTriangle(FPolygonGroupID(static_cast<uint8>(Data.Faces[KeptFaces[KeptIndex]].MatIndex)), VertexInstances);
+	}
+
+	// Nothing reads the geometry of the reader after this point
+	Data.Vertices.Empty();
+	Data.Wedges.Empty();
+	Data.Faces.Empty();
+	Data.Normals.Empty();
+	Data.VertexColors.Empty();
+	Data.ExtraUVs.Empty();
+}
+
+UStaticMesh* UPSKXFactory::CreateStaticMesh(PSKReader& Data, UObject* Parent, FName Name, EObjectFlags Flags, const UPSKImportOptions* Options, FActorXImportReport* Report)
+{
+	FMeshDescription MeshDescription;
+	TMap<FName, uint64> PieceHashes;
+	BuildMeshDescription(Data, Options, MeshDescription, PieceHashes, Report);
+	return CreateStaticMesh(Data, MeshDescription, PieceHashes, Parent, Name, Flags, Options, Report);
+}
+
+UStaticMesh* UPSKXFactory::CreateStaticMesh(PSKReader& Data, FMeshDescription& MeshDescription, const TMap<FName, uint64>& PieceHashes, UObject* Parent, FName Name, EObjectFlags Flags, const UPSKImportOptions* Options, FActorXImportReport* Report)
+{
+	FActorXImportReport::FPhase Phase(Report, TEXT("Materials"));
+	const auto StaticMesh = CastChecked<UStaticMesh>(CreateOrOverwriteAsset(UStaticMesh::StaticClass(), Parent, Name, Flags));
+	
+	for (auto i = 0; i < Data.Materials.Num(); i++)
+	{
+		StaticMesh->GetStaticMaterials().Add(GetImportMaterial(Data.Materials[i], Parent, Flags, Options));
 		StaticMesh->GetSectionInfoMap().Set(0, i, FMeshSectionInfo(i));
 	}
 
@@ -149,27 +298,142 @@ UObject* UPSKXFactory::FactoryCreateFile(UClass* Class, UObject* Parent, FName N
 	//	StaticMesh->AddSocket(NewSocket);
 	//}
 
+	Phase.Next(TEXT("CommitMeshDescription"));
 	auto& SourceModel = StaticMesh->AddSourceModel();
 	SourceModel.BuildSettings.bBuildReversedIndexBuffer = false;
 	SourceModel.BuildSettings.bRecomputeTangents = false;
 	SourceModel.BuildSettings.bGenerateLightmapUVs = false;
 	SourceModel.BuildSettings.bComputeWeightedNormals = false;
 	SourceModel.BuildSettings.bRecomputeNormals = !Data.bHasVertexNormals;
-	SourceModel.SaveRawMesh(RawMesh);
 
+	// The description is moved into the mesh rather than copied
+	StaticMesh->CreateMeshDescription(0, MoveTemp(MeshDescription));
+	StaticMesh->CommitMeshDescription(0);
+
+	Phase.Next(TEXT("BuildStaticMesh"));
 	StaticMesh->Build();
+
+	if (Options->bOptimizeVertexCache && StaticMesh->GetRenderData() && StaticMesh->GetRenderData()->LODResources.Num() > 0)
+	{
+		TArray<uint32> Indices;
+		StaticMesh->GetRenderData()->LODResources[0].IndexBuffer.GetCopy(Indices);
+		FActorXUtils::AddBuiltACMR(Indices, Report);
+	}
+
+	Phase.Next(TEXT("Finalize"));
+
+	const auto ImportData = UActorXAssetImportData::GetOrCreate(StaticMesh, StaticMesh->AssetImportData);
+	ImportData->SetImported(Data.GetFileName(), Options, PieceHashes);
+	StaticMesh->AssetImportData = ImportData;
+
 	StaticMesh->PostEditChange();
 	FAssetRegistryModule::AssetCreated(StaticMesh);
 	StaticMesh->MarkPackageDirty();
 
-	if (!bImportAll)
+	return StaticMesh;
+}
+
+bool UPSKXFactory::CanReimport(UObject* Obj, TArray<FString>& OutFilenames)
+{
+	const auto StaticMesh = Cast<UStaticMesh>(Obj);
+	const auto ImportData = StaticMesh ? Cast<UActorXAssetImportData>(StaticMesh->AssetImportData) : nullptr;
+	if (!ImportData)
 	{
-		SettingsImporter->bInitialized = false;
+		return false;
 	}
 
-	FGlobalComponentReregisterContext RecreateComponents;
-	
-	return StaticMesh;
+	ImportData->ExtractFilenames(OutFilenames);
+	return true;
+}
+
+void UPSKXFactory::SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths)
+{
+	const auto StaticMesh = Cast<UStaticMesh>(Obj);
+	const auto ImportData = StaticMesh ? Cast<UActorXAssetImportData>(StaticMesh->AssetImportData) : nullptr;
+	if (ImportData && ensure(NewReimportPaths.Num() == 1))
+	{
+		ImportData->UpdateFilenameOnly(NewReimportPaths[0]);
+	}
 }
 
+EReimportResult::Type UPSKXFactory::Reimport(UObject* Obj)
+{
+	const auto StaticMesh = Cast<UStaticMesh>(Obj);
+	const auto ImportData = StaticMesh ? Cast<UActorXAssetImportData>(StaticMesh->AssetImportData) : nullptr;
+	if (!ImportData)
+	{
+		return EReimportResult::Failed;
+	}
+
+	const auto Filename = ImportData->GetFirstFilename();
+	const auto Options = ImportData->MakePSKOptions();
+
+	FActorXImportReport Report(Filename);
+	auto Data = PSKReader(Filename);
+	auto bRead = false;
+	{
+		FActorXImportReport::FPhase Phase(&Report, TEXT("Read"));
+		bRead = Data.ReadConverted();
+	}
+	Report.AddChunks(Data.ChunkStats);
+
+	if (!bRead)
+	{
+		UE_LOG(LogActorXImport, Error, TEXT("Failed to reimport %s from %s"), *StaticMesh->GetPathName(), *Filename);
+		Report.Save();
+		return EReimportResult::Failed;
+	}
+
+	// Static meshes are only made of the geometry and the materials
+	const auto NewHashes = FActorXUtils::PrepareMesh(Data, Options, &Report);
+	const auto ChangedPieces = ImportData->GetChangedPieces(NewHashes);
+	Report.AddCount(TEXT("ChangedPieces"), ChangedPieces.Num());
 
+	const auto bRebuild = UActorXAssetImportData::NeedsRebuild(ChangedPieces, { ActorXPieces::Geometry }, Data.Materials.Num(), StaticMesh->GetStaticMaterials().Num());
+
+	if (bRebuild)
+	{
+		UE_LOG(LogActorXImport, Log, TEXT("Rebuilding %s, its geometry changed"), *StaticMesh->GetPathName());
+
+		// The reader was converted and hashed above, the rebuild goes on from there
+		FMeshDescription MeshDescription;
+		BuildMeshDescription(Data, Options, MeshDescription, &Report);
+		const auto Rebuilt = CreateStaticMesh(Data, MeshDescription, NewHashes, StaticMesh->GetOutermost(), StaticMesh->GetFName(), RF_Public | RF_Standalone | RF_Transactional, Options, &Report);
+		if (!Rebuilt)
+		{
+			Report.Save();
+			return EReimportResult::Failed;
+		}
+
+		Report.SetAsset(Rebuilt);
+	}
+	else
+	{
+		FActorXImportReport::FPhase Phase(&Report, TEXT("UpdatePieces"));
+		StaticMesh->PreEditChange(nullptr);
+
+		if (ChangedPieces.Contains(ActorXPieces::Materials))
+		{
+			auto& Materials = StaticMesh->GetStaticMaterials();
+			for (auto i = 0; i < Data.Materials.Num(); i++)
+			{
+				Materials[i] = GetImportMaterial(Data.Materials[i], StaticMesh->GetOutermost(), RF_Public | RF_Standalone | RF_Transactional, Options);
+			}
+		}
+
+		ImportData->Update(Filename);
+		ImportData->PieceHashes = NewHashes;
+
+		StaticMesh->PostEditChange();
+		StaticMesh->MarkPackageDirty();
+		Report.SetAsset(StaticMesh);
+	}
+
+	Report.Save();
+	return EReimportResult::Succeeded;
+}
+
+int32 UPSKXFactory::GetPriority() const
+{
+	return ImportPriority;
+}
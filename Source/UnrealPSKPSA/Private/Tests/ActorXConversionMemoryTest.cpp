@@ -0,0 +1,173 @@
+#include "Factories/PSKFactory.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Readers/PSKReader.h"
+#include "Rendering/SkeletalMeshLODImporterData.h"
+#include "Utils/ActorXSyntheticFiles.h"
+#include "Widgets/PSKImportOptions.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Physical memory growth of one conversion, taken against the memory used before the file was read */
+struct FActorXConversionMemory
+{
+	uint64 StartUsed = 0;
+	uint64 StartPeak = 0;
+	uint64 HeldGrowth = 0;
+	uint64 PeakGrowth = 0;
+
+	FActorXConversionMemory()
+	{
+		const auto Stats = FPlatformMemory::GetStats();
+		StartUsed = Stats.UsedPhysical;
+		StartPeak = Stats.PeakUsedPhysical;
+	}
+
+	/** Called with the converted data still alive */
+	void Finish()
+	{
+		const auto Stats = FPlatformMemory::GetStats();
+		HeldGrowth = Stats.UsedPhysical - FMath::Min(StartUsed, Stats.UsedPhysical);
+		PeakGrowth = Stats.PeakUsedPhysical - FMath::Min(StartUsed, Stats.PeakUsedPhysical);
+	}
+
+	/** The process peak only moves once it is passed, a conversion staying below an earlier peak reads as that peak */
+	bool IsPeakHidden() const
+	{
+		return PeakGrowth <= StartPeak - FMath::Min(StartUsed, StartPeak);
+	}
+};
+
+/**
+ * The conversion as it was before it filled presized arrays: every element is copied by value and added one at a time,
+ * the reader keeps all of its arrays and the unused CopyLODImportData copy is made. Only kept to measure against.
+ */
+static void BuildLegacyImportData(PSKReader& Data, FSkeletalMeshImportData& ImportData, TArray<SkeletalMeshImportData::FMeshWedge>& LODWedges,
+	TArray<SkeletalMeshImportData::FMeshFace>& LODFaces, TArray<SkeletalMeshImportData::FVertInfluence>& LODInfluences, TArray<FVector3f>& LODPoints, TArray<int32>& LODPointToRawMap)
+{
+	Data.Convert();
+
+	for (auto Vertex : Data.Vertices)
+	{
+		ImportData.Points.Add(Vertex);
+		ImportData.PointToRawMap.Add(ImportData.Points.Num() - 1);
+	}
+
+	for (const auto PskFace : Data.Faces)
+	{
+		SkeletalMeshImportData::FTriangle Face;
+		Face.MatIndex = PskFace.MatIndex;
+		Face.SmoothingGroups = 1;
+		Face.AuxMatIndex = 0;
+
+		for (auto VertexIndex = 0; VertexIndex < 3; VertexIndex++)
+		{
+			const auto PskWedge = Data.Wedges[PskFace.WedgeIndex[VertexIndex]];
+
+			SkeletalMeshImportData::FVertex Wedge;
+			Wedge.MatIndex = PskWedge.MatIndex;
+			Wedge.VertexIndex = PskWedge.PointIndex;
+			Wedge.Color = FColor::Black;
+			Wedge.UVs[0] = FVector2f(PskWedge.U, PskWedge.V);
+
+			Face.WedgeIndex[VertexIndex] = ImportData.Wedges.Add(Wedge);
+			Face.TangentZ[VertexIndex] = FVector3f::ZeroVector;
+			Face.TangentY[VertexIndex] = FVector3f::ZeroVector;
+			Face.TangentX[VertexIndex] = FVector3f::ZeroVector;
+		}
+
+		ImportData.Faces.Add(Face);
+	}
+
+	for (auto PskInfluence : Data.Influences)
+	{
+		SkeletalMeshImportData::FRawBoneInfluence Influence;
+		Influence.BoneIndex = PskInfluence.BoneIdx;
+		Influence.VertexIndex = PskInfluence.PointIdx;
+		Influence.Weight = PskInfluence.Weight;
+		ImportData.Influences.Add(Influence);
+	}
+
+	ImportData.CopyLODImportData(LODPoints, LODWedges, LODFaces, LODInfluences, LODPointToRawMap);
+}
+
+static void ReportConversionMemory(FAutomationTestBase& Test, const TCHAR* What, const FActorXConversionMemory& Memory, int64 FileSize)
+{
+	constexpr auto MB = 1024.0 * 1024.0;
+	Test.AddInfo(FString::Printf(TEXT("%s: %.1f MB held (%.2fx the file), %.1f MB peak growth (%.2fx the file)%s"), What,
+		Memory.HeldGrowth / MB, Memory.HeldGrowth / static_cast<double>(FileSize),
+		Memory.PeakGrowth / MB, Memory.PeakGrowth / static_cast<double>(FileSize),
+		Memory.IsPeakHidden() ? TEXT(", below the earlier process peak so the peak is only an upper bound") : TEXT("")));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorXSkeletalConversionMemoryTest, "Plugins.UnrealPSKPSA.Memory.SkeletalMeshConversion",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FActorXSkeletalConversionMemoryTest::RunTest(const FString& Parameters)
+{
+	// A 1M wedge character, about the size the conversion was slimmed down for
+	FActorXSyntheticParams Params;
+	Params.Vertices = 700000;
+	Params.Wedges = 1000000;
+	Params.Faces = 1300000;
+	Params.Bones = 128;
+	Params.Sockets = 0;
+
+	// The legacy copy below only converts UV0
+	Params.UVSets = 0;
+
+	const auto Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("ConversionMemory.psk"));
+	if (!TestTrue(TEXT("Fixture written"), FActorXSyntheticFiles::WritePSK(Filename, Params)))
+	{
+		return false;
+	}
+
+	const auto FileSize = IFileManager::Get().FileSize(*Filename);
+	AddInfo(FString::Printf(TEXT("Fixture: %s, %.1f MB"), *Params.ToString(), FileSize / (1024.0 * 1024.0)));
+
+	// The current path runs first, the legacy one can then only read low if it needs less than the current one
+	FActorXConversionMemory Current;
+	{
+		PSKReader Data(Filename);
+		if (!TestTrue(TEXT("Fixture read"), Data.Read()))
+		{
+			return false;
+		}
+
+		FSkeletalMeshImportData ImportData;
+		TMap<FName, uint64> PieceHashes;
+		UPSKFactory::BuildImportData(Data, GetDefault<UPSKImportOptions>(), ImportData, PieceHashes);
+		Current.Finish();
+	}
+
+	FActorXConversionMemory Legacy;
+	{
+		PSKReader Data(Filename);
+		if (!TestTrue(TEXT("Fixture read"), Data.Read()))
+		{
+			return false;
+		}
+
+		FSkeletalMeshImportData ImportData;
+		TArray<SkeletalMeshImportData::FMeshWedge> LODWedges;
+		TArray<SkeletalMeshImportData::FMeshFace> LODFaces;
+		TArray<SkeletalMeshImportData::FVertInfluence> LODInfluences;
+		TArray<FVector3f> LODPoints;
+		TArray<int32> LODPointToRawMap;
+		BuildLegacyImportData(Data, ImportData, LODWedges, LODFaces, LODInfluences, LODPoints, LODPointToRawMap);
+		Legacy.Finish();
+	}
+
+	ReportConversionMemory(*this, TEXT("Current"), Current, FileSize);
+	ReportConversionMemory(*this, TEXT("Legacy"), Legacy, FileSize);
+
+	// Held memory is what both paths keep for the mesh build, it doesn't depend on the process peak so it is the one checked
+	TestTrue(TEXT("Current conversion holds less than the legacy one"), Current.HeldGrowth < Legacy.HeldGrowth);
+
+	IFileManager::Get().Delete(*Filename);
+	return true;
+}
+
+#endif
@@ -0,0 +1,55 @@
+#include "Factories/PSKFactory.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Readers/PSKReader.h"
+#include "Rendering/SkeletalMeshLODImporterData.h"
+#include "Utils/ActorXSyntheticFiles.h"
+#include "Widgets/PSKImportOptions.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorXSkeletalExtraUVsTest, "Plugins.UnrealPSKPSA.Conversion.ExtraUVs.SkeletalMesh",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FActorXSkeletalExtraUVsTest::RunTest(const FString& Parameters)
+{
+	FActorXSyntheticParams Params;
+	Params.Vertices = 1000;
+	Params.Wedges = 1500;
+	Params.Faces = 1000;
+	Params.UVSets = 2;
+	Params.Bones = 16;
+	Params.Sockets = 0;
+
+	const auto Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("ExtraUVs.psk"));
+	if (!TestTrue(TEXT("Fixture written"), FActorXSyntheticFiles::WritePSK(Filename, Params)))
+	{
+		return false;
+	}
+
+	PSKReader Data(Filename);
+	if (!TestTrue(TEXT("Fixture read"), Data.Read()) || !TestEqual(TEXT("Extra UV sets read"), Data.ExtraUVs.Num(), Params.UVSets))
+	{
+		return false;
+	}
+
+	FSkeletalMeshImportData ImportData;
+	TMap<FName, uint64> PieceHashes;
+	UPSKFactory::BuildImportData(Data, GetDefault<UPSKImportOptions>(), ImportData, PieceHashes);
+
+	// The reader's UVs are released during the conversion, the import data has to keep every set
+	TestEqual(TEXT("Number of UV sets"), static_cast<int32>(ImportData.NumTexCoords), 1 + Params.UVSets);
+
+	// The fixture's UVs are random fractions, so a set that was carried over can't be all zero
+	for (auto Set = 1; Set <= Params.UVSets; Set++)
+	{
+		const auto bHasUVs = ImportData.Wedges.ContainsByPredicate([Set](const SkeletalMeshImportData::FVertex& Wedge) { return !Wedge.UVs[Set].IsNearlyZero(); });
+		TestTrue(FString::Printf(TEXT("UV set %d converted"), Set), bHasUVs);
+	}
+
+	IFileManager::Get().Delete(*Filename);
+	return true;
+}
+
+#endif
@@ -0,0 +1,181 @@
+#include "Factories/PSKFactory.h"
+#include "Factories/PSKXFactory.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "MeshDescription.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Readers/PSKReader.h"
+#include "Rendering/SkeletalMeshLODImporterData.h"
+#include "StaticMeshAttributes.h"
+#include "Utils/ActorXSyntheticFiles.h"
+#include "Widgets/PSKImportOptions.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Switches ActorX.SerialMeshConversion for as long as it lives, so the same loops run on one thread or in parallel */
+class FActorXScopedSerialConversion
+{
+public:
+	explicit FActorXScopedSerialConversion(bool bSerial)
+		: Variable(IConsoleManager::Get().FindConsoleVariable(TEXT("ActorX.SerialMeshConversion")))
+		, bWasSerial(Variable->GetBool())
+	{
+		Variable->Set(bSerial, ECVF_SetByConsole);
+	}
+
+	~FActorXScopedSerialConversion()
+	{
+		Variable->Set(bWasSerial, ECVF_SetByConsole);
+	}
+
+private:
+	IConsoleVariable* Variable;
+	bool bWasSerial;
+};
+
+template <typename T>
+static bool BitsEqual(const T& A, const T& B)
+{
+	return FMemory::Memcmp(&A, &B, sizeof(T)) == 0;
+}
+
+// The import structs have padding nobody writes, so they are compared field by field
+static bool BitsEqual(const SkeletalMeshImportData::FVertex& A, const SkeletalMeshImportData::FVertex& B)
+{
+	return BitsEqual(A.VertexIndex, B.VertexIndex) && BitsEqual(A.UVs, B.UVs) && BitsEqual(A.Color, B.Color) && A.MatIndex == B.MatIndex && A.Reserved == B.Reserved;
+}
+
+static bool BitsEqual(const SkeletalMeshImportData::FTriangle& A, const SkeletalMeshImportData::FTriangle& B)
+{
+	return BitsEqual(A.WedgeIndex, B.WedgeIndex) && A.MatIndex == B.MatIndex && A.AuxMatIndex == B.AuxMatIndex && A.SmoothingGroups == B.SmoothingGroups
+		&& BitsEqual(A.TangentX, B.TangentX) && BitsEqual(A.TangentY, B.TangentY) && BitsEqual(A.TangentZ, B.TangentZ);
+}
+
+template <typename T>
+static void TestSameBits(FAutomationTestBase& Test, const TCHAR* What, TConstArrayView<T> Serial, TConstArrayView<T> Parallel)
+{
+	if (!Test.TestEqual(FString::Printf(TEXT("Number of %s"), What), Parallel.Num(), Serial.Num()))
+	{
+		return;
+	}
+
+	for (auto i = 0; i < Serial.Num(); i++)
+	{
+		if (!BitsEqual(Serial[i], Parallel[i]))
+		{
+			Test.AddError(FString::Printf(TEXT("%s differ first at %d"), What, i));
+			return;
+		}
+	}
+}
+
+/** Writes the fixture both tests convert, large enough for the ParallelFor loops to be split across workers */
+static FString WriteConversionFixture(bool bStaticMesh)
+{
+	FActorXSyntheticParams Params;
+	Params.Vertices = 20000;
+	Params.Wedges = 30000;
+	Params.Faces = 20000;
+	Params.Bones = 64;
+	Params.Sockets = 0;
+
+	const auto Filename = FPaths::Combine(FPaths::AutomationTransientDir(), bStaticMesh ? TEXT("ParallelConversion.pskx") : TEXT("ParallelConversion.psk"));
+	const auto bWritten = bStaticMesh ? FActorXSyntheticFiles::WritePSKX(Filename, Params) : FActorXSyntheticFiles::WritePSK(Filename, Params);
+	return bWritten ? Filename : FString();
+}
+
+static UPSKImportOptions* MakeConversionOptions()
+{
+	// Every option with a parallel loop behind it is on
+	const auto Options = NewObject<UPSKImportOptions>();
+	Options->bWeldWedges = true;
+	Options->bOptimizeVertexCache = true;
+	return Options;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorXParallelSkeletalConversionTest, "Plugins.UnrealPSKPSA.Conversion.ParallelMatchesSerial.SkeletalMesh",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FActorXParallelSkeletalConversionTest::RunTest(const FString& Parameters)
+{
+	const auto Filename = WriteConversionFixture(false);
+	if (!TestFalse(TEXT("Fixture written"), Filename.IsEmpty()))
+	{
+		return false;
+	}
+
+	const auto Options = MakeConversionOptions();
+	FSkeletalMeshImportData Converted[2];
+	for (auto Pass = 0; Pass < 2; Pass++)
+	{
+		// Pass 0 runs with ForceSingleThread, pass 1 with no flags
+		FActorXScopedSerialConversion SerialConversion(Pass == 0);
+		PSKReader Data(Filename);
+		if (!TestTrue(TEXT("Fixture read"), Data.Read()))
+		{
+			return false;
+		}
+
+		TMap<FName, uint64> PieceHashes;
+		UPSKFactory::BuildImportData(Data, Options, Converted[Pass], PieceHashes);
+	}
+
+	const auto& [Serial, Parallel] = Converted;
+	TestSameBits<FVector3f>(*this, TEXT("Points"), Serial.Points, Parallel.Points);
+	TestSameBits<int32>(*this, TEXT("PointToRawMap"), Serial.PointToRawMap, Parallel.PointToRawMap);
+	TestSameBits<SkeletalMeshImportData::FVertex>(*this, TEXT("Wedges"), Serial.Wedges, Parallel.Wedges);
+	TestSameBits<SkeletalMeshImportData::FTriangle>(*this, TEXT("Faces"), Serial.Faces, Parallel.Faces);
+	TestSameBits<SkeletalMeshImportData::FRawBoneInfluence>(*this, TEXT("Influences"), Serial.Influences, Parallel.Influences);
+
+	IFileManager::Get().Delete(*Filename);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorXParallelStaticConversionTest, "Plugins.UnrealPSKPSA.Conversion.ParallelMatchesSerial.StaticMesh",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FActorXParallelStaticConversionTest::RunTest(const FString& Parameters)
+{
+	const auto Filename = WriteConversionFixture(true);
+	if (!TestFalse(TEXT("Fixture written"), Filename.IsEmpty()))
+	{
+		return false;
+	}
+
+	const auto Options = MakeConversionOptions();
+	FMeshDescription Converted[2];
+	for (auto Pass = 0; Pass < 2; Pass++)
+	{
+		// Pass 0 runs with ForceSingleThread, pass 1 with no flags
+		FActorXScopedSerialConversion SerialConversion(Pass == 0);
+		PSKReader Data(Filename);
+		if (!TestTrue(TEXT("Fixture read"), Data.Read()))
+		{
+			return false;
+		}
+
+		TMap<FName, uint64> PieceHashes;
+		UPSKXFactory::BuildMeshDescription(Data, Options, Converted[Pass], PieceHashes);
+	}
+
+	const FStaticMeshConstAttributes Serial(Converted[0]);
+	const FStaticMeshConstAttributes Parallel(Converted[1]);
+	TestSameBits<FVector3f>(*this, TEXT("Vertex positions"), Serial.GetVertexPositions().GetRawArray(), Parallel.GetVertexPositions().GetRawArray());
+	TestSameBits<FVertexID>(*this, TEXT("Vertex instance vertices"), Serial.GetVertexInstanceVertexIndices().GetRawArray(), Parallel.GetVertexInstanceVertexIndices().GetRawArray());
+	TestSameBits<FVector3f>(*this, TEXT("Vertex instance normals"), Serial.GetVertexInstanceNormals().GetRawArray(), Parallel.GetVertexInstanceNormals().GetRawArray());
+	TestSameBits<FVector4f>(*this, TEXT("Vertex instance colors"), Serial.GetVertexInstanceColors().GetRawArray(), Parallel.GetVertexInstanceColors().GetRawArray());
+	TestEqual(TEXT("Number of UV channels"), Parallel.GetVertexInstanceUVs().GetNumChannels(), Serial.GetVertexInstanceUVs().GetNumChannels());
+	for (auto Channel = 0; Channel < Serial.GetVertexInstanceUVs().GetNumChannels(); Channel++)
+	{
+		TestSameBits<FVector2f>(*this, TEXT("Vertex instance UVs"), Serial.GetVertexInstanceUVs().GetRawArray(Channel), Parallel.GetVertexInstanceUVs().GetRawArray(Channel));
+	}
+	TestSameBits<FVertexInstanceID>(*this, TEXT("Triangle corners"), Serial.GetTriangleVertexInstanceIndices().GetRawArray(), Parallel.GetTriangleVertexInstanceIndices().GetRawArray());
+	TestSameBits<FPolygonGroupID>(*this, TEXT("Triangle polygon groups"), Serial.GetTrianglePolygonGroupIndices().GetRawArray(), Parallel.GetTrianglePolygonGroupIndices().GetRawArray());
+	TestSameBits<FName>(*this, TEXT("Polygon group slot names"), Serial.GetPolygonGroupMaterialSlotNames().GetRawArray(), Parallel.GetPolygonGroupMaterialSlotNames().GetRawArray());
+
+	IFileManager::Get().Delete(*Filename);
+	return true;
+}
+
+#endif
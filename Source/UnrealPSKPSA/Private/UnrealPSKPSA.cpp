@@ -1,16 +1,73 @@
 ﻿// Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UnrealPSKPSA.h"
+#include "ContentBrowserMenuContexts.h"
+#include "DesktopPlatformModule.h"
+#include "Framework/Application/SlateApplication.h"
+#include "IDesktopPlatform.h"
+#include "ToolMenus.h"
+#include "Utils/ActorXAsyncImporter.h"
+#include "Utils/ActorXSkeletonIndex.h"
+
+DEFINE_LOG_CATEGORY(LogActorXImport);
+
+static void ImportActorXFiles(const FString& PackagePath)
+{
+	const auto DesktopPlatform = FDesktopPlatformModule::Get();
+	if (!DesktopPlatform)
+	{
+		return;
+	}
+
+	TArray<FString> Files;
+	const auto ParentWindowHandle = FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr);
+	if (DesktopPlatform->OpenFileDialog(ParentWindowHandle, TEXT("Import ActorX Files"), TEXT(""), TEXT(""), TEXT("ActorX Files (*.psk;*.pskx;*.psa)|*.psk;*.pskx;*.psa"), EFileDialogFlags::Multiple, Files))
+	{
+		FActorXAsyncImporter::Start(Files, PackagePath);
+	}
+}
 
 void FUnrealPSKPSAModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FUnrealPSKPSAModule::RegisterMenus));
+	FActorXSkeletonIndex::Register();
 }
 
 void FUnrealPSKPSAModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	UToolMenus::UnRegisterStartupCallback(this);
+	UToolMenus::UnregisterOwner(this);
+	FActorXSkeletonIndex::Unregister();
+}
+
+void FUnrealPSKPSAModule::RegisterMenus()
+{
+	FToolMenuOwnerScoped OwnerScoped(this);
+
+	const auto Menu = UToolMenus::Get()->ExtendMenu("ContentBrowser.FolderContextMenu");
+	auto& Section = Menu->FindOrAddSection("PathViewFolderOptions");
+	Section.AddDynamicEntry("ImportActorXAsync", FNewToolMenuSectionDelegate::CreateLambda([](FToolMenuSection& InSection)
+	{
+		const auto Context = InSection.FindContext<UContentBrowserFolderContext>();
+		if (!Context || Context->GetSelectedPackagePaths().Num() != 1)
+		{
+			return;
+		}
+
+		// Files are read and converted on the worker threads, the editor stays usable while they come in
+		InSection.AddMenuEntry(
+			"ImportActorXAsync",
+			NSLOCTEXT("UnrealPSKPSA", "ImportActorXAsync", "Import ActorX Files (Async)"),
+			NSLOCTEXT("UnrealPSKPSA", "ImportActorXAsyncTooltip", "Import .psk/.pskx/.psa files into this folder without blocking the editor"),
+			FSlateIcon(),
+			FUIAction(FExecuteAction::CreateLambda([PackagePath = Context->GetSelectedPackagePaths()[0]]
+			{
+				ImportActorXFiles(PackagePath);
+			})));
+	}));
 }
 
 IMPLEMENT_MODULE(FUnrealPSKPSAModule, UnrealPSKPSA)
\ No newline at end of file
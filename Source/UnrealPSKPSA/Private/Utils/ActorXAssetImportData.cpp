@@ -0,0 +1,198 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Utils/ActorXAssetImportData.h"
+#include "Hash/xxhash.h"
+#include "Readers/PSAReader.h"
+#include "Readers/PSKReader.h"
+#include "Widgets/PSAImportOptions.h"
+#include "Widgets/PSKImportOptions.h"
+
+template <typename T>
+static void HashArray(FXxHash64Builder& Builder, const TArray<T>& Array)
+{
+	const auto Num = Array.Num();
+	Builder.Update(&Num, sizeof(Num));
+	Builder.Update(Array.GetData(), Array.Num() * sizeof(T));
+}
+
+static void HashString(FXxHash64Builder& Builder, const FString& String)
+{
+	HashArray(Builder, String.GetCharArray());
+}
+
+UActorXAssetImportData* UActorXAssetImportData::GetOrCreate(UObject* Asset, UAssetImportData* ImportData)
+{
+	if (const auto ActorXImportData = Cast<UActorXAssetImportData>(ImportData))
+	{
+		return ActorXImportData;
+	}
+
+	const auto NewImportData = NewObject<UActorXAssetImportData>(Asset, NAME_None, RF_NoFlags);
+	if (ImportData)
+	{
+		NewImportData->SourceData = ImportData->SourceData;
+	}
+
+	return NewImportData;
+}
+
+TMap<FName, uint64> UActorXAssetImportData::HashMesh(const PSKReader& Data)
+{
+	TMap<FName, uint64> Hashes;
+
+	FXxHash64Builder Geometry;
+	HashArray(Geometry, Data.Vertices);
+	HashArray(Geometry, Data.Wedges);
+	HashArray(Geometry, Data.Normals);
+	HashArray(Geometry, Data.VertexColors);
+	for (const auto& UVs : Data.ExtraUVs)
+	{
+		HashArray(Geometry, UVs);
+	}
+
+	// Faces have padding between their fields, so only the fields are hashed
+	TArray<uint32> FaceFields;
+	FaceFields.Reserve(Data.Faces.Num() * 5);
+	for (const auto& Face : Data.Faces)
+	{
+		FaceFields.Append({ static_cast<uint32>(Face.WedgeIndex[0]), static_cast<uint32>(Face.WedgeIndex[1]), static_cast<uint32>(Face.WedgeIndex[2]),
+			static_cast<uint32>(static_cast<uint8>(Face.MatIndex)) | static_cast<uint32>(static_cast<uint8>(Face.AuxMatIndex)) << 8, Face.SmoothingGroups });
+	}
+	HashArray(Geometry, FaceFields);
+	Hashes.Add(ActorXPieces::Geometry, Geometry.Finalize().Hash);
+
+	FXxHash64Builder Skinning;
+	HashArray(Skinning, Data.Influences);
+	Hashes.Add(ActorXPieces::Skinning, Skinning.Finalize().Hash);
+
+	// Bones have padding in front of their 16 byte aligned orientation, so only the fields are hashed
+	FXxHash64Builder Skeleton;
+	const auto NumBones = Data.Bones.Num();
+	Skeleton.Update(&NumBones, sizeof(NumBones));
+	for (const auto& Bone : Data.Bones)
+	{
+		const auto& Pos = Bone.BonePos;
+		const int32 BoneFields[] = { Bone.Flags, Bone.NumChildren, Bone.ParentIndex };
+		const float PosFields[] = { Pos.Orientation.X, Pos.Orientation.Y, Pos.Orientation.Z, Pos.Orientation.W, Pos.Position.X, Pos.Position.Y, Pos.Position.Z,
+			Pos.Length, Pos.XSize, Pos.YSize, Pos.ZSize };
+		Skeleton.Update(Bone.Name, sizeof(Bone.Name));
+		Skeleton.Update(BoneFields, sizeof(BoneFields));
+		Skeleton.Update(PosFields, sizeof(PosFields));
+	}
+	Hashes.Add(ActorXPieces::Skeleton, Skeleton.Finalize().Hash);
+
+	FXxHash64Builder Materials;
+	HashArray(Materials, Data.Materials);
+	Hashes.Add(ActorXPieces::Materials, Materials.Finalize().Hash);
+
+	FXxHash64Builder Sockets;
+	for (const auto& Socket : Data.Sockets)
+	{
+		HashString(Sockets, Socket.SocketName);
+		HashString(Sockets, Socket.BoneName);
+		Sockets.Update(&Socket.RelativeLocation, sizeof(Socket.RelativeLocation));
+		Sockets.Update(&Socket.RelativeRotation, sizeof(Socket.RelativeRotation));
+		Sockets.Update(&Socket.RelativeScale, sizeof(Socket.RelativeScale));
+	}
+	Hashes.Add(ActorXPieces::Sockets, Sockets.Finalize().Hash);
+
+	return Hashes;
+}
+
+uint64 UActorXAssetImportData::HashSequence(const PSAReader& Data, int32 SequenceIndex, TConstArrayView<FPSABoneTrack> Tracks)
+{
+	FXxHash64Builder Builder;
+	Builder.Update(&Data.AnimInfo[SequenceIndex], sizeof(VAnimInfoBinary));
+
+	// Tracks are bound to the bones by name
+	for (const auto& Bone : Data.Bones)
+	{
+		Builder.Update(Bone.Name, sizeof(Bone.Name));
+	}
+
+	for (const auto& Track : Tracks)
+	{
+		HashArray(Builder, Track.PositionalKeys);
+		HashArray(Builder, Track.RotationalKeys);
+		HashArray(Builder, Track.ScaleKeys);
+	}
+
+	return Builder.Finalize().Hash;
+}
+
+TSet<FName> UActorXAssetImportData::GetChangedPieces(const TMap<FName, uint64>& NewHashes) const
+{
+	TSet<FName> Changed;
+	for (const auto& [Piece, Hash] : NewHashes)
+	{
+		const auto OldHash = PieceHashes.Find(Piece);
+		if (!OldHash || *OldHash != Hash)
+		{
+			Changed.Add(Piece);
+		}
+	}
+
+	for (const auto& [Piece, Hash] : PieceHashes)
+	{
+		if (!NewHashes.Contains(Piece))
+		{
+			Changed.Add(Piece);
+		}
+	}
+
+	return Changed;
+}
+
+bool UActorXAssetImportData::NeedsRebuild(const TSet<FName>& ChangedPieces, TConstArrayView<FName> RebuiltPieces, int32 NumMaterials, int32 NumAssetMaterials)
+{
+	return NumMaterials != NumAssetMaterials || RebuiltPieces.ContainsByPredicate([&ChangedPieces](FName Piece) { return ChangedPieces.Contains(Piece); });
+}
+
+void UActorXAssetImportData::SetImported(const FString& Filename, const UPSKImportOptions* Options, const TMap<FName, uint64>& InPieceHashes)
+{
+	Update(Filename);
+	SetOptions(Options);
+	PieceHashes = InPieceHashes;
+}
+
+void UActorXAssetImportData::SetOptions(const UPSKImportOptions* Options)
+{
+	bCreateMaterials = Options->bCreateMaterials;
+	bLoadProperties = Options->bLoadProperties;
+	bWeldWedges = Options->bWeldWedges;
+	WeldUVTolerance = Options->WeldUVTolerance;
+	bOptimizeVertexCache = Options->bOptimizeVertexCache;
+	bMergeMaterials = Options->bMergeMaterials;
+	MaxBoneInfluences = Options->MaxBoneInfluences;
+	BoneInfluenceThreshold = Options->BoneInfluenceThreshold;
+	bReuseSkeleton = Options->bReuseSkeleton;
+}
+
+void UActorXAssetImportData::SetOptions(const UPSAImportOptions* Options)
+{
+	bLoadProperties = Options->bLoadProperties;
+	bCreateFolder = Options->bCreateFolder;
+}
+
+UPSKImportOptions* UActorXAssetImportData::MakePSKOptions() const
+{
+	const auto Options = NewObject<UPSKImportOptions>(GetTransientPackage());
+	Options->bCreateMaterials = bCreateMaterials;
+	Options->bLoadProperties = bLoadProperties;
+	Options->bWeldWedges = bWeldWedges;
+	Options->WeldUVTolerance = WeldUVTolerance;
+	Options->bOptimizeVertexCache = bOptimizeVertexCache;
+	Options->bMergeMaterials = bMergeMaterials;
+	Options->MaxBoneInfluences = MaxBoneInfluences;
+	Options->BoneInfluenceThreshold = BoneInfluenceThreshold;
+	Options->bReuseSkeleton = bReuseSkeleton;
+	return Options;
+}
+
+UPSAImportOptions* UActorXAssetImportData::MakePSAOptions() const
+{
+	const auto Options = NewObject<UPSAImportOptions>(GetTransientPackage());
+	Options->bLoadProperties = bLoadProperties;
+	Options->bCreateFolder = bCreateFolder;
+	return Options;
+}
@@ -0,0 +1,364 @@
+#include "Utils/ActorXAsyncImporter.h"
+#include "UnrealPSKPSA.h"
+#include "Async/ParallelFor.h"
+#include "ComponentReregisterContext.h"
+#include "Containers/Ticker.h"
+#include "Factories/PSAFactory.h"
+#include "Factories/PSKFactory.h"
+#include "Factories/PSKXFactory.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "MeshDescription.h"
+#include "HAL/IConsoleManager.h"
+#include "ObjectTools.h"
+#include "Readers/PSAReader.h"
+#include "Readers/PSKReader.h"
+#include "Rendering/SkeletalMeshLODImporterData.h"
+#include "Utils/ActorXImportReport.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Widgets/PSAImportOptions.h"
+#include "Widgets/PSKImportOptions.h"
+
+static TAutoConsoleVariable<float> CVarActorXAsyncImportFrameBudgetMs(
+	TEXT("ActorX.AsyncImportFrameBudgetMs"),
+	10.0f,
+	TEXT("Time the game thread spends creating assets per frame during an async ActorX import, at least one asset is created every frame."));
+
+/** A file of the batch, filled in on a worker and handed to the game thread once its task is done */
+struct FActorXAsyncImporter::FFile
+{
+	explicit FFile(const FString& InFilename)
+		: Filename(InFilename), Extension(FPaths::GetExtension(InFilename).ToLower()), Report(InFilename)
+	{
+	}
+
+	FString Filename;
+	FString Extension;
+	FActorXImportReport Report;
+
+	// Only one of the readers is set
+	TUniquePtr<PSKReader> Mesh;
+	TUniquePtr<PSAReader> Anim;
+
+	FSkeletalMeshImportData SkeletalMeshImportData;
+	FMeshDescription MeshDescription;
+	TMap<FName, uint64> PieceHashes;
+	TArray<TArray<FPSABoneTrack>> Tracks;
+	TArray<bool> DecodedTracks;
+
+	int32 NextSequence = 0;
+	int32 NumFailedSequences = 0;
+	bool bSuccess = false;
+};
+
+static bool IsActorXFile(const FString& Extension)
+{
+	return Extension == TEXT("psk") || Extension == TEXT("pskx") || Extension == TEXT("psa");
+}
+
+bool FActorXAsyncImporter::Start(const TArray<FString>& InFiles, const FString& InPackagePath)
+{
+	const auto Importer = MakeShared<FActorXAsyncImporter>();
+	Importer->PackagePath = InPackagePath;
+
+	for (const auto& Filename : InFiles)
+	{
+		if (IsActorXFile(FPaths::GetExtension(Filename).ToLower()))
+		{
+			Importer->Filenames.Add(Filename);
+		}
+	}
+
+	if (Importer->Filenames.IsEmpty() || !Importer->ConfigureOptions())
+	{
+		return false;
+	}
+
+	FNotificationInfo Info(NSLOCTEXT("ActorXAsyncImporter", "Importing", "Importing ActorX files"));
+	Info.bFireAndForget = false;
+	Info.ExpireDuration = 3.0f;
+	Info.ButtonDetails.Add(FNotificationButtonInfo(NSLOCTEXT("ActorXAsyncImporter", "Cancel", "Cancel"), FText::GetEmpty(),
+		FSimpleDelegate::CreateSP(Importer, &FActorXAsyncImporter::Cancel), SNotificationItem::CS_Pending));
+
+	Importer->Notification = FSlateNotificationManager::Get().AddNotification(Info);
+	if (Importer->Notification)
+	{
+		Importer->Notification->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+
+	UE_LOG(LogActorXImport, Log, TEXT("Importing %d files into %s"), Importer->Filenames.Num(), *InPackagePath);
+
+	// The options are only read by the workers, the factories keep them alive until the queue has waited for the last worker
+	const UPSKImportOptions* PSKOptions = Importer->PSKFactory ? Importer->PSKFactory->SettingsImporter : nullptr;
+	const UPSKImportOptions* PSKXOptions = Importer->PSKXFactory ? Importer->PSKXFactory->SettingsImporter : nullptr;
+	const auto bLoadAnimProperties = Importer->PSAFactory && Importer->PSAFactory->SettingsImporter->bLoadProperties;
+
+	Importer->Queue = MakeUnique<TActorXDecodeQueue<TSharedPtr<FFile>>>(Importer->Filenames.Num(), TActorXDecodeQueue<TSharedPtr<FFile>>::GetDefaultMaxInFlight(),
+		[Filenames = Importer->Filenames, PSKOptions, PSKXOptions, bLoadAnimProperties](int32 FileIndex)
+		{
+			const auto File = MakeShared<FFile>(Filenames[FileIndex]);
+			DecodeFile(*File, PSKOptions, PSKXOptions, bLoadAnimProperties);
+			return File;
+		});
+
+	// The ticker keeps the importer alive until its last file is done
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Importer](float DeltaTime)
+	{
+		return Importer->Tick(DeltaTime);
+	}));
+
+	return true;
+}
+
+void FActorXAsyncImporter::DecodeFile(FFile& File, const UPSKImportOptions* PSKOptions, const UPSKImportOptions* PSKXOptions, bool bLoadAnimProperties)
+{
+	ACTORX_TRACE_SCOPE("ActorX.AsyncDecode");
+
+	if (File.Extension == TEXT("psa"))
+	{
+		File.Anim = MakeUnique<PSAReader>(File.Filename, bLoadAnimProperties);
+		auto& Data = *File.Anim;
+		{
+			FActorXImportReport::FPhase Phase(&File.Report, TEXT("Read"));
+			if (!Data.OpenConverted()) return;
+		}
+		File.Report.AddChunks(Data.ChunkStats);
+		File.Report.AddCount(TEXT("Bones"), Data.Bones.Num());
+		File.Report.AddCount(TEXT("Sequences"), Data.AnimInfo.Num());
+		File.Report.AddCount(TEXT("ParseCacheHit"), Data.bFromCache ? 1 : 0);
+
+		// Unlike the factory the whole file is decoded up front, the sequences are then created a few per frame
+		FActorXImportReport::FPhase Phase(&File.Report, TEXT("DecodeTracks"));
+		File.Tracks.SetNum(Data.AnimInfo.Num());
+		File.DecodedTracks.Init(false, Data.AnimInfo.Num());
+		ParallelFor(File.Tracks.Num(), [&](int32 SequenceIndex)
+		{
+			File.DecodedTracks[SequenceIndex] = Data.ReadConvertedTracks(SequenceIndex, File.Tracks[SequenceIndex]);
+		});
+
+		// The tables and properties stay, only the file or cache entry is let go
+		Data.Close();
+	}
+	else
+	{
+		// Properties are only used by skeletal meshes
+		const auto bStaticMesh = File.Extension == TEXT("pskx");
+		File.Mesh = MakeUnique<PSKReader>(File.Filename, !bStaticMesh && PSKOptions->bLoadProperties);
+		auto& Data = *File.Mesh;
+		{
+			FActorXImportReport::FPhase Phase(&File.Report, TEXT("Read"));
+			if (!Data.ReadConverted()) return;
+		}
+		File.Report.AddChunks(Data.ChunkStats);
+
+		if (bStaticMesh)
+		{
+			UPSKXFactory::BuildMeshDescription(Data, PSKXOptions, File.MeshDescription, File.PieceHashes, &File.Report);
+		}
+		else
+		{
+			UPSKFactory::BuildImportData(Data, PSKOptions, File.SkeletalMeshImportData, File.PieceHashes, &File.Report);
+		}
+	}
+
+	File.bSuccess = true;
+}
+
+bool FActorXAsyncImporter::ConfigureOptions()
+{
+	const auto HasExtension = [this](const TCHAR* Extension)
+	{
+		return Filenames.ContainsByPredicate([Extension](const FString& Filename) { return FPaths::GetExtension(Filename).ToLower() == Extension; });
+	};
+
+	// Every file type asks once for the whole batch
+	if (HasExtension(TEXT("psk")))
+	{
+		PSKFactory.Reset(NewObject<UPSKFactory>());
+		if (!PSKFactory->ConfigureOptions())
+		{
+			return false;
+		}
+	}
+
+	if (HasExtension(TEXT("pskx")))
+	{
+		PSKXFactory.Reset(NewObject<UPSKXFactory>());
+		if (!PSKXFactory->ConfigureOptions())
+		{
+			return false;
+		}
+	}
+
+	if (HasExtension(TEXT("psa")))
+	{
+		PSAFactory.Reset(NewObject<UPSAFactory>());
+		if (!PSAFactory->ConfigureOptions())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FActorXAsyncImporter::Tick(float DeltaTime)
+{
+	if (bCancelled)
+	{
+		Finish();
+		return false;
+	}
+
+	const auto Deadline = FPlatformTime::Seconds() + CVarActorXAsyncImportFrameBudgetMs.GetValueOnGameThread() / 1000.0;
+	while (Queue->IsNextReady())
+	{
+		if (!FinishFile(*Queue->GetNext(), Deadline))
+		{
+			break;
+		}
+
+		// Drop the decoded data as soon as its assets exist
+		Queue->PopNext();
+
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			break;
+		}
+	}
+
+	if (Queue->IsDone())
+	{
+		Finish();
+		return false;
+	}
+
+	if (Notification)
+	{
+		Notification->SetText(FText::Format(NSLOCTEXT("ActorXAsyncImporter", "Progress", "Importing ActorX files ({0}/{1})"), FText::AsNumber(Queue->GetNextIndex()), FText::AsNumber(Filenames.Num())));
+	}
+
+	return true;
+}
+
+bool FActorXAsyncImporter::FinishFile(FFile& File, double Deadline)
+{
+	if (!File.bSuccess)
+	{
+		UE_LOG(LogActorXImport, Error, TEXT("Failed to read %s"), *File.Filename);
+		NumFailed++;
+		return true;
+	}
+
+	const auto AssetName = ObjectTools::SanitizeObjectName(FPaths::GetBaseFilename(File.Filename));
+	const auto Parent = CreatePackage(*FPaths::Combine(PackagePath, AssetName));
+	const auto Flags = RF_Public | RF_Standalone | RF_Transactional;
+
+	UObject* Asset = nullptr;
+	if (File.Anim)
+	{
+		// A file with hundreds of sequences is spread over several frames, at least one sequence is created per call
+		FActorXImportReport::FPhase Phase(&File.Report, TEXT("AnimController"));
+		while (File.NextSequence < File.Tracks.Num())
+		{
+			// A sequence with bad keys is skipped, the others in the file are still imported
+			const auto Created = File.DecodedTracks[File.NextSequence]
+				? PSAFactory->CreateAnimSequence(*File.Anim, File.NextSequence, File.Tracks[File.NextSequence], Parent, Flags, PSAFactory->SettingsImporter)
+				: nullptr;
+			if (Created)
+			{
+				Asset = Created;
+				File.Report.SetAsset(Asset);
+			}
+			else
+			{
+				UE_LOG(LogActorXImport, Error, TEXT("Failed to read the keys of %s from %s, skipping it"), ANSI_TO_TCHAR(File.Anim->AnimInfo[File.NextSequence].Name), *File.Filename);
+				File.NumFailedSequences++;
+				NumFailed++;
+			}
+
+			File.Tracks[File.NextSequence].Empty();
+			File.NextSequence++;
+
+			if (File.NextSequence < File.Tracks.Num() && FPlatformTime::Seconds() >= Deadline)
+			{
+				return false;
+			}
+		}
+
+		File.Report.AddCount(TEXT("FailedSequences"), File.NumFailedSequences);
+	}
+	else if (File.Extension == TEXT("pskx"))
+	{
+		Asset = PSKXFactory->CreateStaticMesh(*File.Mesh, File.MeshDescription, File.PieceHashes, Parent, FName(AssetName), Flags, PSKXFactory->SettingsImporter, &File.Report);
+		File.Report.SetAsset(Asset);
+	}
+	else
+	{
+		Asset = PSKFactory->CreateSkeletalMesh(*File.Mesh, File.SkeletalMeshImportData, File.PieceHashes, Parent, FName(AssetName), Flags, PSKFactory->SettingsImporter, &File.Report);
+		File.Report.SetAsset(Asset);
+	}
+
+	File.Report.Save();
+
+	// A PSA without any sequence has nothing to import but didn't fail either
+	if (Asset || (File.Anim && File.Tracks.IsEmpty()))
+	{
+		NumImported++;
+	}
+	else
+	{
+		UE_LOG(LogActorXImport, Error, TEXT("Failed to import %s"), *File.Filename);
+		NumFailed++;
+	}
+
+	return true;
+}
+
+void FActorXAsyncImporter::Finish()
+{
+	const auto NumFiles = Filenames.Num();
+
+	// Waits for the files still being decoded, they read the options of the factories released with the importer
+	Queue.Reset();
+
+	// Components using the new assets are recreated once for the whole batch
+	if (NumImported > 0)
+	{
+		FGlobalComponentReregisterContext RecreateComponents;
+	}
+
+	// The next import asks for the options again, like the factories do without "Import All"
+	if (PSKFactory)
+	{
+		PSKFactory->SettingsImporter->bInitialized = false;
+	}
+
+	if (PSKXFactory)
+	{
+		PSKXFactory->SettingsImporter->bInitialized = false;
+	}
+
+	if (PSAFactory)
+	{
+		PSAFactory->SettingsImporter->bInitialized = false;
+	}
+
+	UE_LOG(LogActorXImport, Log, TEXT("Imported %d of %d files%s"), NumImported, NumFiles, bCancelled ? TEXT(", the import was cancelled") : TEXT(""));
+
+	if (Notification)
+	{
+		const auto Text = bCancelled
+			? NSLOCTEXT("ActorXAsyncImporter", "Cancelled", "Cancelled the ActorX import ({0}/{1} files imported)")
+			: NSLOCTEXT("ActorXAsyncImporter", "Done", "Imported {0}/{1} ActorX files");
+
+		Notification->SetText(FText::Format(Text, FText::AsNumber(NumImported), FText::AsNumber(NumFiles)));
+		Notification->SetCompletionState(bCancelled || NumFailed > 0 ? SNotificationItem::CS_Fail : SNotificationItem::CS_Success);
+		Notification->ExpireAndFadeout();
+		Notification.Reset();
+	}
+}
+
+void FActorXAsyncImporter::Cancel()
+{
+	bCancelled = true;
+}
@@ -0,0 +1,198 @@
+#include "Utils/ActorXImportReport.h"
+#include "UnrealPSKPSA.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+static TAutoConsoleVariable<bool> CVarActorXImportReport(
+	TEXT("ActorX.ImportReport"),
+	false,
+	TEXT("Write a JSON timing report for every ActorX import."));
+
+static TAutoConsoleVariable<FString> CVarActorXImportReportDir(
+	TEXT("ActorX.ImportReportDir"),
+	TEXT(""),
+	TEXT("Directory the ActorX import reports are written to, defaults to Saved/ActorXImportReports."));
+
+FActorXImportReport::FPhase::FPhase(FActorXImportReport* InReport, const TCHAR* InName)
+	: Report(InReport)
+{
+	Begin(InName);
+}
+
+FActorXImportReport::FPhase::~FPhase()
+{
+	End();
+}
+
+void FActorXImportReport::FPhase::Next(const TCHAR* InName)
+{
+	End();
+	Begin(InName);
+}
+
+void FActorXImportReport::FPhase::Begin(const TCHAR* InName)
+{
+	Name = InName;
+	StartCycles = FPlatformTime::Cycles64();
+
+#if CPUPROFILERTRACE_ENABLED
+	bTraced = UE_TRACE_CHANNELEXPR_IS_ENABLED(ActorXChannel);
+	if (bTraced)
+	{
+		FCpuProfilerTrace::OutputBeginDynamicEvent(Name);
+	}
+#endif
+}
+
+void FActorXImportReport::FPhase::End()
+{
+	if (!Name)
+	{
+		return;
+	}
+
+#if CPUPROFILERTRACE_ENABLED
+	if (bTraced)
+	{
+		FCpuProfilerTrace::OutputEndEvent();
+	}
+#endif
+
+	if (Report)
+	{
+		Report->AddPhase(Name, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles));
+		Report->SampleMemory();
+	}
+
+	Name = nullptr;
+}
+
+FActorXImportReport::FActorXImportReport(const FString& InSourceFile)
+	: SourceFile(InSourceFile)
+{
+	StartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	PeakUsedPhysical = StartUsedPhysical;
+}
+
+void FActorXImportReport::AddPhase(const FString& Name, double Seconds)
+{
+	// Phases that run more than once, e.g. once per batch of sequences, are summed
+	const auto Found = Phases.FindByPredicate([&Name](const TPair<FString, double>& Phase) { return Phase.Key == Name; });
+	if (Found)
+	{
+		Found->Value += Seconds;
+	}
+	else
+	{
+		Phases.Emplace(Name, Seconds);
+	}
+}
+
+void FActorXImportReport::AddChunks(TConstArrayView<FActorXChunkStats> Chunks)
+{
+	ChunkStats.Append(Chunks.GetData(), Chunks.Num());
+}
+
+void FActorXImportReport::AddCount(const FString& Name, int64 Count)
+{
+	Counts.Emplace(Name, Count);
+}
+
+void FActorXImportReport::AddMetric(const FString& Name, double Value)
+{
+	Metrics.Emplace(Name, Value);
+}
+
+void FActorXImportReport::SetAsset(const UObject* Asset)
+{
+	AssetPath = Asset ? Asset->GetPathName() : FString();
+	AssetClass = Asset ? Asset->GetClass()->GetName() : FString();
+}
+
+void FActorXImportReport::SampleMemory()
+{
+	PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+}
+
+void FActorXImportReport::Save() const
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	auto ReportDir = CVarActorXImportReportDir.GetValueOnGameThread();
+	if (ReportDir.IsEmpty())
+	{
+		ReportDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ActorXImportReports"));
+	}
+
+	const auto Timestamp = FDateTime::UtcNow();
+	const auto Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("Source"), SourceFile);
+	Report->SetNumberField(TEXT("SourceBytes"), IFileManager::Get().FileSize(*SourceFile));
+	Report->SetStringField(TEXT("Asset"), AssetPath);
+	Report->SetStringField(TEXT("Class"), AssetClass);
+	Report->SetBoolField(TEXT("Succeeded"), !AssetPath.IsEmpty());
+	Report->SetStringField(TEXT("Timestamp"), Timestamp.ToIso8601());
+
+	auto TotalSeconds = 0.0;
+	const auto PhaseObject = MakeShared<FJsonObject>();
+	for (const auto& [Name, Seconds] : Phases)
+	{
+		PhaseObject->SetNumberField(Name, Seconds);
+		TotalSeconds += Seconds;
+	}
+	Report->SetObjectField(TEXT("Phases"), PhaseObject);
+	Report->SetNumberField(TEXT("TotalSeconds"), TotalSeconds);
+
+	const auto CountObject = MakeShared<FJsonObject>();
+	for (const auto& [Name, Count] : Counts)
+	{
+		CountObject->SetNumberField(Name, Count);
+	}
+	Report->SetObjectField(TEXT("Counts"), CountObject);
+
+	const auto MetricObject = MakeShared<FJsonObject>();
+	for (const auto& [Name, Value] : Metrics)
+	{
+		MetricObject->SetNumberField(Name, Value);
+	}
+	Report->SetObjectField(TEXT("Metrics"), MetricObject);
+
+	const auto MemoryObject = MakeShared<FJsonObject>();
+	MemoryObject->SetNumberField(TEXT("StartUsedPhysical"), StartUsedPhysical);
+	MemoryObject->SetNumberField(TEXT("PeakUsedPhysical"), PeakUsedPhysical);
+	MemoryObject->SetNumberField(TEXT("PeakGrowth"), PeakUsedPhysical - StartUsedPhysical);
+	Report->SetObjectField(TEXT("Memory"), MemoryObject);
+
+	TArray<TSharedPtr<FJsonValue>> ChunkValues;
+	for (const auto& Chunk : ChunkStats)
+	{
+		const auto ChunkObject = MakeShared<FJsonObject>();
+		ChunkObject->SetStringField(TEXT("Id"), Chunk.ChunkID);
+		ChunkObject->SetNumberField(TEXT("Bytes"), Chunk.Bytes);
+		ChunkObject->SetNumberField(TEXT("Elements"), Chunk.Elements);
+		ChunkObject->SetNumberField(TEXT("Seconds"), Chunk.Seconds);
+		ChunkValues.Add(MakeShared<FJsonValueObject>(ChunkObject));
+	}
+	Report->SetArrayField(TEXT("Chunks"), ChunkValues);
+
+	FString Json;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&Json));
+
+	const auto ReportFile = FPaths::Combine(ReportDir, FString::Printf(TEXT("%s_%s.json"), *FPaths::GetBaseFilename(SourceFile), *Timestamp.ToString()));
+	if (!FFileHelper::SaveStringToFile(Json, *ReportFile))
+	{
+		UE_LOG(LogActorXImport, Warning, TEXT("Failed to write the import report %s"), *ReportFile);
+	}
+}
+
+bool FActorXImportReport::IsEnabled()
+{
+	return CVarActorXImportReport.GetValueOnGameThread();
+}
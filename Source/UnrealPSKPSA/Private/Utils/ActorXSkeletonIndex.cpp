@@ -0,0 +1,293 @@
+#include "Utils/ActorXSkeletonIndex.h"
+#include "UnrealPSKPSA.h"
+#include "Animation/Skeleton.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Readers/ActorXTrace.h"
+
+const FName FActorXSkeletonIndex::FingerprintTag(TEXT("ActorXBoneFingerprint"));
+const FName FActorXSkeletonIndex::RootBoneTag(TEXT("ActorXRootBone"));
+const FName FActorXSkeletonIndex::BoneCountTag(TEXT("ActorXBoneCount"));
+const FName FActorXSkeletonIndex::BoneSetTag(TEXT("ActorXBoneSet"));
+
+// Reference poses are compared to a tenth of a millimetre and a ten-thousandth of a quaternion component
+static constexpr double PoseTolerance = 1e-4;
+
+static FDelegateHandle ExtraTagsHandle;
+
+// Bloom filter of the lowercased bone names, two bits per name out of 1024 keep unrelated skeletons of a few hundred bones apart
+static constexpr int32 BoneSetWords = 32;
+using FActorXBoneSet = TStaticArray<uint32, BoneSetWords>;
+
+static FActorXBoneSet GetBoneSet(const FReferenceSkeleton& RefSkeleton)
+{
+	FActorXBoneSet BoneSet(InPlace, 0);
+	for (const auto& BoneInfo : RefSkeleton.GetRawRefBoneInfo())
+	{
+		const auto Name = BoneInfo.Name.ToString().ToLower();
+		const auto Hash = FXxHash64::HashBuffer(*Name, Name.Len() * sizeof(TCHAR)).Hash;
+		for (const auto Bit : { static_cast<uint32>(Hash), static_cast<uint32>(Hash >> 32) })
+		{
+			BoneSet[(Bit / 32) % BoneSetWords] |= 1u << (Bit % 32);
+		}
+	}
+
+	return BoneSet;
+}
+
+static FString BoneSetToString(const FActorXBoneSet& BoneSet)
+{
+	FString Result;
+	Result.Reserve(BoneSetWords * 8);
+	for (const auto Word : BoneSet)
+	{
+		Result.Appendf(TEXT("%08x"), Word);
+	}
+
+	return Result;
+}
+
+static bool ParseBoneSet(const FString& String, FActorXBoneSet& OutBoneSet)
+{
+	if (String.Len() != BoneSetWords * 8)
+	{
+		return false;
+	}
+
+	for (auto Word = 0; Word < BoneSetWords; Word++)
+	{
+		OutBoneSet[Word] = FParse::HexNumber(*String.Mid(Word * 8, 8));
+	}
+
+	return true;
+}
+
+/** A bloom filter has no false negatives, so a name missing from Outer's bits is missing from its bones */
+static bool MightContainAll(const FActorXBoneSet& Outer, const FActorXBoneSet& Inner)
+{
+	for (auto Word = 0; Word < BoneSetWords; Word++)
+	{
+		if (Inner[Word] & ~Outer[Word])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void AddSkeletonTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& OutTags)
+{
+	const auto Skeleton = Cast<USkeleton>(Object);
+	if (!Skeleton || Skeleton->GetReferenceSkeleton().GetRawBoneNum() == 0)
+	{
+		return;
+	}
+
+	const auto& RefSkeleton = Skeleton->GetReferenceSkeleton();
+	OutTags.Emplace(FActorXSkeletonIndex::FingerprintTag, FString::Printf(TEXT("%016llx"), FActorXSkeletonIndex::Fingerprint(RefSkeleton)), UObject::FAssetRegistryTag::TT_Hidden);
+	OutTags.Emplace(FActorXSkeletonIndex::RootBoneTag, RefSkeleton.GetRawRefBoneInfo()[0].Name.ToString().ToLower(), UObject::FAssetRegistryTag::TT_Hidden);
+	OutTags.Emplace(FActorXSkeletonIndex::BoneCountTag, FString::FromInt(RefSkeleton.GetRawBoneNum()), UObject::FAssetRegistryTag::TT_Hidden);
+	OutTags.Emplace(FActorXSkeletonIndex::BoneSetTag, BoneSetToString(GetBoneSet(RefSkeleton)), UObject::FAssetRegistryTag::TT_Hidden);
+}
+
+void FActorXSkeletonIndex::Register()
+{
+	ExtraTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTags.AddStatic(&AddSkeletonTags);
+}
+
+void FActorXSkeletonIndex::Unregister()
+{
+	UObject::FAssetRegistryTag::OnGetExtraObjectTags.Remove(ExtraTagsHandle);
+}
+
+uint64 FActorXSkeletonIndex::Fingerprint(const FReferenceSkeleton& RefSkeleton)
+{
+	FXxHash64Builder Builder;
+	const auto& BoneInfos = RefSkeleton.GetRawRefBoneInfo();
+	const auto& BonePoses = RefSkeleton.GetRawRefBonePose();
+	for (auto BoneIndex = 0; BoneIndex < BoneInfos.Num(); BoneIndex++)
+	{
+		// Bone names are FNames, which don't care about case
+		const auto Name = BoneInfos[BoneIndex].Name.ToString().ToLower();
+		Builder.Update(*Name, Name.Len() * sizeof(TCHAR));
+		Builder.Update(&BoneInfos[BoneIndex].ParentIndex, sizeof(int32));
+
+		const auto& Pose = BonePoses[BoneIndex];
+		const auto Location = Pose.GetLocation();
+		const auto Rotation = Pose.GetRotation().GetNormalized();
+		const int64 Quantized[7] =
+		{
+			FMath::RoundToInt64(Location.X / PoseTolerance), FMath::RoundToInt64(Location.Y / PoseTolerance), FMath::RoundToInt64(Location.Z / PoseTolerance),
+			FMath::RoundToInt64(Rotation.X / PoseTolerance), FMath::RoundToInt64(Rotation.Y / PoseTolerance), FMath::RoundToInt64(Rotation.Z / PoseTolerance), FMath::RoundToInt64(Rotation.W / PoseTolerance)
+		};
+		Builder.Update(Quantized, sizeof(Quantized));
+	}
+
+	return Builder.Finalize().Hash;
+}
+
+// Virtual bones only exist on skeletons, so everything here works on the raw bones
+static FName GetRawBoneName(const FReferenceSkeleton& RefSkeleton, int32 BoneIndex)
+{
+	return RefSkeleton.GetRawRefBoneInfo()[BoneIndex].Name;
+}
+
+static bool BonesMatch(const FReferenceSkeleton& A, int32 BoneA, const FReferenceSkeleton& B, int32 BoneB)
+{
+	const auto ParentA = A.GetRawParentIndex(BoneA);
+	const auto ParentB = B.GetRawParentIndex(BoneB);
+	if ((ParentA == INDEX_NONE) != (ParentB == INDEX_NONE) || (ParentA != INDEX_NONE && GetRawBoneName(A, ParentA) != GetRawBoneName(B, ParentB)))
+	{
+		return false;
+	}
+
+	const auto& PoseA = A.GetRawRefBonePose()[BoneA];
+	const auto& PoseB = B.GetRawRefBonePose()[BoneB];
+	return PoseA.GetLocation().Equals(PoseB.GetLocation(), PoseTolerance) && PoseA.GetRotation().Equals(PoseB.GetRotation(), PoseTolerance);
+}
+
+EActorXSkeletonMatch FActorXSkeletonIndex::Match(const FReferenceSkeleton& MeshSkeleton, const FReferenceSkeleton& Skeleton)
+{
+	// Both have to agree on the root, or the hierarchies can't line up
+	if (MeshSkeleton.GetRawBoneNum() == 0 || Skeleton.GetRawBoneNum() == 0 || GetRawBoneName(MeshSkeleton, 0) != GetRawBoneName(Skeleton, 0))
+	{
+		return EActorXSkeletonMatch::None;
+	}
+
+	auto NumShared = 0;
+	for (auto BoneIndex = 0; BoneIndex < MeshSkeleton.GetRawBoneNum(); BoneIndex++)
+	{
+		const auto SkeletonBone = Skeleton.FindRawBoneIndex(GetRawBoneName(MeshSkeleton, BoneIndex));
+		if (SkeletonBone == INDEX_NONE)
+		{
+			continue;
+		}
+
+		if (!BonesMatch(MeshSkeleton, BoneIndex, Skeleton, SkeletonBone))
+		{
+			return EActorXSkeletonMatch::None;
+		}
+
+		NumShared++;
+	}
+
+	if (NumShared == MeshSkeleton.GetRawBoneNum())
+	{
+		return NumShared == Skeleton.GetRawBoneNum() ? EActorXSkeletonMatch::Exact : EActorXSkeletonMatch::Subset;
+	}
+
+	return NumShared == Skeleton.GetRawBoneNum() ? EActorXSkeletonMatch::Superset : EActorXSkeletonMatch::None;
+}
+
+// Decides from the registry tags alone whether a skeleton can be a subset or superset match, so the others are never loaded
+static bool MightMatch(const FAssetData& Candidate, int32 MeshBoneCount, const FActorXBoneSet& MeshBoneSet)
+{
+	int32 BoneCount = 0;
+	FString BoneSetString;
+	FActorXBoneSet BoneSet;
+	if (!Candidate.GetTagValue(FActorXSkeletonIndex::BoneCountTag, BoneCount) || !Candidate.GetTagValue(FActorXSkeletonIndex::BoneSetTag, BoneSetString)
+		|| !ParseBoneSet(BoneSetString, BoneSet))
+	{
+		// Tagged by an older version of the plugin, only loading it tells
+		return true;
+	}
+
+	return (BoneCount >= MeshBoneCount && MightContainAll(BoneSet, MeshBoneSet)) || (BoneCount <= MeshBoneCount && MightContainAll(MeshBoneSet, BoneSet));
+}
+
+// Engine and plugin content is shared with other projects, merging bones into it would dirty a skeleton that can't or shouldn't be saved
+static bool IsWritableProjectContent(const FAssetData& Candidate)
+{
+	const auto PackageName = Candidate.PackageName.ToString();
+	if (!PackageName.StartsWith(TEXT("/Game/")))
+	{
+		return false;
+	}
+
+	// Packages that were never saved have no file yet and can be written
+	FString Filename;
+	return !FPackageName::TryConvertLongPackageNameToFilename(PackageName, Filename, FPackageName::GetAssetPackageExtension()) || !IFileManager::Get().IsReadOnly(*Filename);
+}
+
+USkeleton* FActorXSkeletonIndex::FindCompatible(const FReferenceSkeleton& MeshSkeleton, EActorXSkeletonMatch& OutMatch)
+{
+	ACTORX_TRACE_SCOPE("ActorX.FindSkeleton");
+
+	OutMatch = EActorXSkeletonMatch::None;
+	if (MeshSkeleton.GetRawBoneNum() == 0)
+	{
+		return nullptr;
+	}
+
+	const auto& AssetRegistry = FAssetRegistryModule::GetRegistry();
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(USkeleton::StaticClass()->GetClassPathName());
+	Filter.TagsAndValues.Add(FingerprintTag, FString::Printf(TEXT("%016llx"), Fingerprint(MeshSkeleton)));
+
+	// Candidates are sorted by path so the same project always binds to the same skeleton
+	TArray<FAssetData> Candidates;
+	AssetRegistry.GetAssets(Filter, Candidates);
+	Candidates.Sort([](const FAssetData& A, const FAssetData& B) { return A.GetSoftObjectPath().LexicalLess(B.GetSoftObjectPath()); });
+
+	// The fingerprint can collide or be stale, every candidate is checked once it is loaded
+	for (const auto& Candidate : Candidates)
+	{
+		const auto Skeleton = Cast<USkeleton>(Candidate.GetAsset());
+		if (Skeleton && Match(MeshSkeleton, Skeleton->GetReferenceSkeleton()) == EActorXSkeletonMatch::Exact)
+		{
+			OutMatch = EActorXSkeletonMatch::Exact;
+			return Skeleton;
+		}
+	}
+
+	Filter.TagsAndValues.Reset();
+	Filter.TagsAndValues.Add(RootBoneTag, GetRawBoneName(MeshSkeleton, 0).ToString().ToLower());
+
+	Candidates.Reset();
+	AssetRegistry.GetAssets(Filter, Candidates);
+	Candidates.Sort([](const FAssetData& A, const FAssetData& B) { return A.GetSoftObjectPath().LexicalLess(B.GetSoftObjectPath()); });
+
+	const auto MeshBoneSet = GetBoneSet(MeshSkeleton);
+	Candidates.RemoveAll([&](const FAssetData& Candidate) { return !MightMatch(Candidate, MeshSkeleton.GetRawBoneNum(), MeshBoneSet); });
+
+	// A skeleton the mesh fits in is left untouched, so it is preferred over one the mesh would add bones to
+	USkeleton* Superset = nullptr;
+	for (const auto& Candidate : Candidates)
+	{
+		const auto Skeleton = Cast<USkeleton>(Candidate.GetAsset());
+		if (!Skeleton)
+		{
+			continue;
+		}
+
+		const auto SkeletonMatch = Match(MeshSkeleton, Skeleton->GetReferenceSkeleton());
+		if (SkeletonMatch == EActorXSkeletonMatch::Exact || SkeletonMatch == EActorXSkeletonMatch::Subset)
+		{
+			OutMatch = SkeletonMatch;
+			return Skeleton;
+		}
+
+		if (SkeletonMatch == EActorXSkeletonMatch::Superset && !Superset && IsWritableProjectContent(Candidate))
+		{
+			Superset = Skeleton;
+		}
+	}
+
+	if (Superset)
+	{
+		OutMatch = EActorXSkeletonMatch::Superset;
+	}
+
+	return Superset;
+}
+
+void FActorXSkeletonIndex::UpdateTags(const USkeleton* Skeleton)
+{
+	// The registry asks AddSkeletonTags again, with the bones the skeleton has now
+	IAssetRegistry::GetChecked().AssetTagsFinalized(*Skeleton);
+}
@@ -0,0 +1,78 @@
+#include "Utils/ActorXUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Readers/PSKReader.h"
+#include "Utils/ActorXAssetImportData.h"
+#include "Utils/ActorXImportReport.h"
+#include "Utils/ActorXVertexCache.h"
+#include "Widgets/PSKImportOptions.h"
+
+static TAutoConsoleVariable<bool> CVarActorXSerialMeshConversion(
+	TEXT("ActorX.SerialMeshConversion"),
+	false,
+	TEXT("Convert ActorX meshes on a single thread instead of in parallel, the output is the same."));
+
+EParallelForFlags FActorXUtils::GetConversionFlags()
+{
+	return CVarActorXSerialMeshConversion.GetValueOnAnyThread() ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+}
+
+TMap<FName, uint64> FActorXUtils::PrepareMesh(PSKReader& Data, const UPSKImportOptions* Options, FActorXImportReport* Report)
+{
+	Data.Convert();
+
+	if (Options->bMergeMaterials)
+	{
+		const auto NumMerged = Data.MergeMaterials();
+		if (Report)
+		{
+			Report->AddCount(TEXT("MergedMaterials"), NumMerged);
+		}
+	}
+
+	return UActorXAssetImportData::HashMesh(Data);
+}
+
+TArray<FColor> FActorXUtils::GetVertexColorsByPoint(const PSKReader& Data)
+{
+	TArray<FColor> VertexColorsByPoint;
+	if (Data.bHasVertexColors)
+	{
+		VertexColorsByPoint.Init(FColor::Black, Data.Vertices.Num());
+		for (auto i = 0; i < Data.Wedges.Num(); i++)
+		{
+			VertexColorsByPoint[Data.Wedges[i].PointIndex] = Data.VertexColors[i];
+		}
+	}
+
+	return VertexColorsByPoint;
+}
+
+void FActorXUtils::OptimizeFaceOrder(TConstArrayView<int32> CornerWedges, TConstArrayView<int32> Sections, TArray<int32>& OutOrder, FActorXImportReport* Report)
+{
+	FActorXVertexCache::OptimizeFaceOrder(CornerWedges, Sections, OutOrder, GetConversionFlags());
+
+	// Measuring walks the whole index list twice, so it only happens when someone reads the numbers
+	if (Report && FActorXImportReport::IsEnabled())
+	{
+		Report->AddMetric(TEXT("ACMRBefore"), FActorXVertexCache::ComputeACMR(CornerWedges));
+		Report->AddMetric(TEXT("ACMRAfter"), FActorXVertexCache::ComputeACMR(CornerWedges, OutOrder));
+	}
+}
+
+void FActorXUtils::AddBuiltACMR(TConstArrayView<uint32> Indices, FActorXImportReport* Report)
+{
+	if (!Report || !FActorXImportReport::IsEnabled())
+	{
+		return;
+	}
+
+	// Sections are contiguous in the index buffer, so the whole buffer is walked in the order it is drawn
+	TArray<int32> Corners;
+	Corners.SetNumUninitialized(Indices.Num());
+	for (auto i = 0; i < Indices.Num(); i++)
+	{
+		Corners[i] = static_cast<int32>(Indices[i]);
+	}
+
+	Report->AddMetric(TEXT("ACMRBuilt"), FActorXVertexCache::ComputeACMR(Corners));
+}
@@ -6,4 +6,5 @@ UPSAImportOptions::UPSAImportOptions()
 {
 	Skeleton = nullptr;
 	bCreateFolder = false;
+	bLoadProperties = false;
 }
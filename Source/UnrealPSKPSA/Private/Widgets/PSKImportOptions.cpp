@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Widgets/PSKImportOptions.h"
+#include "GPUSkinPublicDefs.h"
 
 UPSKImportOptions::UPSKImportOptions()
 {
@@ -9,5 +10,15 @@ UPSKImportOptions::UPSKImportOptions()
 	bLoadProperties = false;
 	bCreateSockets = false;
 
+	bWeldWedges = true;
+	WeldUVTolerance = 0.f;
+	bOptimizeVertexCache = false;
+	bMergeMaterials = false;
+
+	// Every influence the engine can skin with is kept, pruning further is opt in
+	MaxBoneInfluences = MAX_TOTAL_INFLUENCES;
+	BoneInfluenceThreshold = 0.f;
+	bReuseSkeleton = true;
+
 	bSkeletalMesh = false;
 }
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ImportActorXCommandlet.generated.h"
+
+class UPSAFactory;
+class UPSAImportOptions;
+class UPSKFactory;
+class UPSKImportOptions;
+class UPSKXFactory;
+
+/**
+ * Imports .psk/.pskx/.psa files without any UI, for example
+ * UnrealEditor-Cmd Project.uproject -run=ImportActorX -Source=<directory or manifest> -Dest=/Game/Imported -Options=<options.json> -unattended -nullrhi
+ *
+ * Files are decoded on the worker threads a few at a time while the game thread creates the assets of the files
+ * that are already decoded. The manifest is a text file with one path per line, relative paths are relative to the manifest.
+ * The options file is a JSON object with optional "PSK" and "PSA" objects holding UPSKImportOptions and UPSAImportOptions properties.
+ */
+UCLASS()
+class UNREALPSKPSA_API UImportActorXCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UImportActorXCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	bool LoadOptions(const FString& OptionsFile);
+
+	UPROPERTY()
+	TObjectPtr<UPSKImportOptions> PSKOptions;
+
+	UPROPERTY()
+	TObjectPtr<UPSAImportOptions> PSAOptions;
+
+	UPROPERTY()
+	TObjectPtr<UPSKFactory> PSKFactory;
+
+	UPROPERTY()
+	TObjectPtr<UPSKXFactory> PSKXFactory;
+
+	UPROPERTY()
+	TObjectPtr<UPSAFactory> PSAFactory;
+};
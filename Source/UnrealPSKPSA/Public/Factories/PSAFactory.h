@@ -2,16 +2,22 @@
 
 #pragma once
 #include "CoreMinimal.h"
+#include "EditorReimportHandler.h"
 #include "Factories/Factory.h"
 #include "Widgets/PSAImportOptions.h"
 #include "PSAFactory.generated.h"
 
+class FActorXImportReport;
+class PSAReader;
+class UAnimSequence;
+struct FPSABoneTrack;
+
 /**
  * Implements a factory for UnrealPSKPSA animation objects.
  */
  
 UCLASS(hidecategories=Object)
-class UNREALPSKPSA_API UPSAFactory : public UFactory
+class UNREALPSKPSA_API UPSAFactory : public UFactory, public FReimportHandler
 {
 	GENERATED_UCLASS_BODY()
 	
@@ -23,4 +29,23 @@ class UNREALPSKPSA_API UPSAFactory : public UFactory
 	bool bCancel;
 
 	virtual UObject* FactoryCreateFile(UClass* Class, UObject* Parent, FName Name, EObjectFlags Flags, const FString& Filename, const TCHAR* Params, FFeedbackContext* Warn, bool& bOutOperationCanceled) override;
+
+	/** FReimportHandler, only the pieces whose hash changed since the last import are rebuilt */
+	virtual bool CanReimport(UObject* Obj, TArray<FString>& OutFilenames) override;
+	virtual void SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths) override;
+	virtual EReimportResult::Type Reimport(UObject* Obj) override;
+	virtual int32 GetPriority() const override;
+
+	/** Shows the options dialog unless the options are already set, returns false if the import was cancelled */
+	bool ConfigureOptions();
+
+	/**
+	 * Creates one sequence per entry in ANIMINFO, the reader has to be open with ANIMINFO and BONENAMES decoded.
+	 * Keys are decoded on the worker threads, the sequences are created on the game thread. Sequences whose keys fail to decode
+	 * are skipped and counted as FailedSequences. Returns the last sequence created.
+	 */
+	UAnimSequence* CreateAnimSequences(const PSAReader& Data, UObject* Parent, EObjectFlags Flags, const UPSAImportOptions* Options, FActorXImportReport* Report = nullptr);
+
+	/** Creates the sequence of a single ANIMINFO entry from its converted tracks, has to run on the game thread. Returns null without a track per bone */
+	UAnimSequence* CreateAnimSequence(const PSAReader& Data, int32 SequenceIndex, const TArray<FPSABoneTrack>& Tracks, UObject* Parent, EObjectFlags Flags, const UPSAImportOptions* Options);
 };
@@ -2,16 +2,21 @@
 
 #pragma once
 #include "CoreMinimal.h"
+#include "EditorReimportHandler.h"
 #include "Factories/Factory.h"
 #include "Widgets/PSKImportOptions.h"
 #include "PSKFactory.generated.h"
 
+class FActorXImportReport;
+class PSKReader;
+class USkeletalMesh;
+
 /**
  * Implements a factory for UnrealPSKPSA skeletal mesh objects.
  */
  
 UCLASS(hidecategories=Object)
-class UNREALPSKPSA_API UPSKFactory : public UFactory
+class UNREALPSKPSA_API UPSKFactory : public UFactory, public FReimportHandler
 {
 	GENERATED_UCLASS_BODY()
 
@@ -23,8 +28,37 @@ class UNREALPSKPSA_API UPSKFactory : public UFactory
 	bool bCancel;
 
 	virtual UObject* FactoryCreateFile(UClass* Class, UObject* Parent, FName Name, EObjectFlags Flags, const FString& Filename, const TCHAR* Params, FFeedbackContext* Warn, bool& bOutOperationCanceled) override;
+
+	/** FReimportHandler, only the pieces whose hash changed since the last import are rebuilt */
+	virtual bool CanReimport(UObject* Obj, TArray<FString>& OutFilenames) override;
+	virtual void SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths) override;
+	virtual EReimportResult::Type Reimport(UObject* Obj) override;
+	virtual int32 GetPriority() const override;
+
+	/** Shows the options dialog unless the options are already set, returns false if the import was cancelled */
+	bool ConfigureOptions();
+
+	/**
+	 * Converts a file that has already been read into import data, doesn't touch any UObject so it can run on a worker thread.
+	 * The geometry and influences are moved or released out of the reader, so its piece hashes are taken here.
+	 */
+	static void BuildImportData(PSKReader& Data, const UPSKImportOptions* Options, FSkeletalMeshImportData& OutImportData, TMap<FName, uint64>& OutPieceHashes, FActorXImportReport* Report = nullptr);
+
+	/** Same as above for a reader FActorXUtils::PrepareMesh has already converted and hashed, like the one a reimport compares */
+	static void BuildImportData(PSKReader& Data, const UPSKImportOptions* Options, FSkeletalMeshImportData& OutImportData, FActorXImportReport* Report = nullptr);
+
+	/** Builds the skeletal mesh and its skeleton from a file that has already been read, has to run on the game thread */
+	USkeletalMesh* CreateSkeletalMesh(PSKReader& Data, UObject* Parent, FName Name, EObjectFlags Flags, const UPSKImportOptions* Options, FActorXImportReport* Report = nullptr);
+
+	/**
+	 * Same as above with the import data already built by BuildImportData, only the materials are filled in.
+	 * A reimport passes the mesh's current skeleton, which is kept as long as the new bones still match it.
+	 */
+	USkeletalMesh* CreateSkeletalMesh(PSKReader& Data, FSkeletalMeshImportData& ImportData, const TMap<FName, uint64>& PieceHashes, UObject* Parent, FName Name, EObjectFlags Flags,
+		const UPSKImportOptions* Options, FActorXImportReport* Report = nullptr, USkeleton* ExistingSkeleton = nullptr);
+
+	/** The skeleton's depth is measured once by the bone table in BuildImportData, which reports it as SkeletonDepth */
 	static void ProcessSkeleton(const FSkeletalMeshImportData&    ImportData,
 	                            const USkeleton*                  Skeleton,
-	                            FReferenceSkeleton&               OutRefSkeleton,
-	                            int32&                            OutSkeletalDepth);
+	                            FReferenceSkeleton&               OutRefSkeleton);
 };
@@ -2,16 +2,22 @@
 
 #pragma once
 #include "CoreMinimal.h"
+#include "EditorReimportHandler.h"
 #include "Factories/Factory.h"
 #include "Widgets/PSKImportOptions.h"
 #include "PSKXFactory.generated.h"
 
+class FActorXImportReport;
+class PSKReader;
+class UStaticMesh;
+struct FMeshDescription;
+
 /**
  * Implements a factory for UnrealPSKPSA mesh objects.
  */
  
 UCLASS(hidecategories=Object)
-class UNREALPSKPSA_API UPSKXFactory : public UFactory
+class UNREALPSKPSA_API UPSKXFactory : public UFactory, public FReimportHandler
 {
 	GENERATED_UCLASS_BODY()
 
@@ -23,4 +29,28 @@ class UNREALPSKPSA_API UPSKXFactory : public UFactory
 	bool bCancel;
 
 	virtual UObject* FactoryCreateFile(UClass* Class, UObject* Parent, FName Name, EObjectFlags Flags, const FString& Filename, const TCHAR* Params, FFeedbackContext* Warn, bool& bOutOperationCanceled) override;
+
+	/** FReimportHandler, only the pieces whose hash changed since the last import are rebuilt */
+	virtual bool CanReimport(UObject* Obj, TArray<FString>& OutFilenames) override;
+	virtual void SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths) override;
+	virtual EReimportResult::Type Reimport(UObject* Obj) override;
+	virtual int32 GetPriority() const override;
+
+	/** Shows the options dialog unless the options are already set, returns false if the import was cancelled */
+	bool ConfigureOptions();
+
+	/**
+	 * Converts a file that has already been read into a mesh description, doesn't touch any UObject so it can run on a worker thread.
+	 * The geometry is released out of the reader, so its piece hashes are taken here.
+	 */
+	static void BuildMeshDescription(PSKReader& Data, const UPSKImportOptions* Options, FMeshDescription& OutMeshDescription, TMap<FName, uint64>& OutPieceHashes, FActorXImportReport* Report = nullptr);
+
+	/** Same as above for a reader FActorXUtils::PrepareMesh has already converted and hashed, like the one a reimport compares */
+	static void BuildMeshDescription(PSKReader& Data, const UPSKImportOptions* Options, FMeshDescription& OutMeshDescription, FActorXImportReport* Report = nullptr);
+
+	/** Builds the static mesh from a file that has already been read, has to run on the game thread */
+	UStaticMesh* CreateStaticMesh(PSKReader& Data, UObject* Parent, FName Name, EObjectFlags Flags, const UPSKImportOptions* Options, FActorXImportReport* Report = nullptr);
+
+	/** Same as above with the mesh description already built by BuildMeshDescription, it is moved into the mesh */
+	UStaticMesh* CreateStaticMesh(PSKReader& Data, FMeshDescription& MeshDescription, const TMap<FName, uint64>& PieceHashes, UObject* Parent, FName Name, EObjectFlags Flags, const UPSKImportOptions* Options, FActorXImportReport* Report = nullptr);
 };
@@ -4,6 +4,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogActorXImport, Log, All);
+
 class FUnrealPSKPSAModule : public IModuleInterface
 {
 public:
@@ -11,4 +13,8 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	/** Adds "Import ActorX Files (Async)" to the folder context menu of the content browser */
+	void RegisterMenus();
 };
@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "EditorFramework/AssetImportData.h"
+#include "GPUSkinPublicDefs.h"
+#include "ActorXAssetImportData.generated.h"
+
+class PSAReader;
+class PSKReader;
+class UPSAImportOptions;
+class UPSKImportOptions;
+struct FPSABoneTrack;
+
+/** Pieces of an ActorX asset that a reimport can update on its own */
+namespace ActorXPieces
+{
+	// PNTS0000, VTXW0000, FACE0000/FACE3200, VTXNORMS, VERTEXCOLOR and EXTRAUVS
+	inline const FName Geometry(TEXT("Geometry"));
+	// RAWWEIGHTS
+	inline const FName Skinning(TEXT("Skinning"));
+	// REFSKELT
+	inline const FName Skeleton(TEXT("Skeleton"));
+	// MATT0000
+	inline const FName Materials(TEXT("Materials"));
+	// Sockets of the properties file
+	inline const FName Sockets(TEXT("Sockets"));
+	// ANIMINFO entry, bone names and keys of a single sequence
+	inline const FName Sequence(TEXT("Sequence"));
+}
+
+/**
+ * Import data of assets created from ActorX files. Along with the source file it keeps a hash of every piece of the asset
+ * and the options it was imported with, so a reimport can skip the pieces that didn't change.
+ * The hashes are taken from the decoded data rather than the raw chunks so they are the same when the file comes from the parse cache.
+ */
+UCLASS()
+class UNREALPSKPSA_API UActorXAssetImportData : public UAssetImportData
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TMap<FName, uint64> PieceHashes;
+
+	UPROPERTY()
+	bool bCreateMaterials = true;
+
+	UPROPERTY()
+	bool bLoadProperties = false;
+
+	UPROPERTY()
+	bool bCreateFolder = false;
+
+	UPROPERTY()
+	bool bWeldWedges = true;
+
+	UPROPERTY()
+	float WeldUVTolerance = 0.f;
+
+	UPROPERTY()
+	bool bOptimizeVertexCache = false;
+
+	UPROPERTY()
+	bool bMergeMaterials = false;
+
+	UPROPERTY()
+	int32 MaxBoneInfluences = MAX_TOTAL_INFLUENCES;
+
+	UPROPERTY()
+	float BoneInfluenceThreshold = 0.f;
+
+	UPROPERTY()
+	bool bReuseSkeleton = true;
+
+	/** Returns the ActorX import data of an asset, import data of another type is replaced and its source files kept */
+	static UActorXAssetImportData* GetOrCreate(UObject* Asset, UAssetImportData* ImportData);
+
+	static TMap<FName, uint64> HashMesh(const PSKReader& Data);
+	static uint64 HashSequence(const PSAReader& Data, int32 SequenceIndex, TConstArrayView<FPSABoneTrack> Tracks);
+
+	/** Pieces whose hash differs from the stored one, pieces missing on either side count as changed */
+	TSet<FName> GetChangedPieces(const TMap<FName, uint64>& NewHashes) const;
+
+	/**
+	 * Whether a reimport rebuilds the mesh instead of updating the changed pieces in place.
+	 * Sections refer to their material by index, so a different number of materials needs a rebuild too.
+	 */
+	static bool NeedsRebuild(const TSet<FName>& ChangedPieces, TConstArrayView<FName> RebuiltPieces, int32 NumMaterials, int32 NumAssetMaterials);
+
+	/** Keeps the source file, options and piece hashes of a mesh that was just built, so a reimport can tell which pieces changed */
+	void SetImported(const FString& Filename, const UPSKImportOptions* Options, const TMap<FName, uint64>& InPieceHashes);
+
+	void SetOptions(const UPSKImportOptions* Options);
+	void SetOptions(const UPSAImportOptions* Options);
+
+	/** Transient options holding what the asset was imported with */
+	UPSKImportOptions* MakePSKOptions() const;
+	UPSAImportOptions* MakePSAOptions() const;
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Utils/ActorXDecodeQueue.h"
+
+class SNotificationItem;
+class UPSAFactory;
+class UPSKFactory;
+class UPSKImportOptions;
+class UPSKXFactory;
+
+/**
+ * Imports ActorX files without blocking the editor. Reading, converting and building the import data of every file
+ * runs on UE::Tasks workers, the game thread only creates the assets of the files that are done, within a frame budget
+ * (ActorX.AsyncImportFrameBudgetMs) so the editor stays responsive while a large batch comes in.
+ * Progress is shown in a notification instead of a modal slow task, the import can be cancelled from it.
+ */
+class UNREALPSKPSA_API FActorXAsyncImporter : public TSharedFromThis<FActorXAsyncImporter>
+{
+public:
+	/** Asks for the options of every file type in the batch and starts importing into PackagePath, returns false if it was cancelled */
+	static bool Start(const TArray<FString>& Files, const FString& PackagePath);
+
+private:
+	struct FFile;
+
+	/** Runs on a worker, reads the file and builds everything that doesn't need a UObject */
+	static void DecodeFile(FFile& File, const UPSKImportOptions* PSKOptions, const UPSKImportOptions* PSKXOptions, bool bLoadAnimProperties);
+
+	bool ConfigureOptions();
+	bool Tick(float DeltaTime);
+
+	/** Creates the assets of a decoded file, returns false if it still has sequences left once the deadline is reached */
+	bool FinishFile(FFile& File, double Deadline);
+	void Finish();
+	void Cancel();
+
+	TArray<FString> Filenames;
+	TUniquePtr<TActorXDecodeQueue<TSharedPtr<FFile>>> Queue;
+	FString PackagePath;
+
+	TStrongObjectPtr<UPSKFactory> PSKFactory;
+	TStrongObjectPtr<UPSKXFactory> PSKXFactory;
+	TStrongObjectPtr<UPSAFactory> PSAFactory;
+
+	TSharedPtr<SNotificationItem> Notification;
+
+	int32 NumImported = 0;
+	int32 NumFailed = 0;
+	bool bCancelled = false;
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+/**
+ * Decodes a batch of files on UE::Tasks workers while the game thread consumes them in order.
+ * Decoded files are held until the game thread gets to them, so the workers are kept at most MaxInFlight files ahead of it,
+ * which bounds how much is kept in memory. The consumer either waits for the next file or polls it without blocking.
+ * Destroying the queue waits for the files still being decoded, so whatever the decode function points to only has to outlive the queue.
+ */
+template <typename ResultType>
+class TActorXDecodeQueue
+{
+public:
+	using FDecodeFunc = TFunction<ResultType(int32 FileIndex)>;
+
+	/** Decode runs on the workers, once per file index */
+	TActorXDecodeQueue(int32 InNumFiles, int32 InMaxInFlight, FDecodeFunc InDecode)
+		: Decode(MakeShared<FDecodeFunc>(MoveTemp(InDecode))), NumFiles(InNumFiles), MaxInFlight(FMath::Max(1, InMaxInFlight))
+	{
+		Tasks.Reserve(NumFiles);
+		LaunchTasks();
+	}
+
+	/** At most MaxInFlight files are still being decoded, their results are dropped */
+	~TActorXDecodeQueue()
+	{
+		for (auto i = NextFile; i < Tasks.Num(); i++)
+		{
+			Tasks[i].Wait();
+		}
+	}
+
+	TActorXDecodeQueue(const TActorXDecodeQueue&) = delete;
+	TActorXDecodeQueue& operator=(const TActorXDecodeQueue&) = delete;
+
+	/** One decoded file per worker thread */
+	static int32 GetDefaultMaxInFlight()
+	{
+		return FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	}
+
+	int32 Num() const { return NumFiles; }
+	int32 GetNextIndex() const { return NextFile; }
+	bool IsDone() const { return NextFile == NumFiles; }
+	bool IsNextReady() const { return !IsDone() && Tasks[NextFile].IsCompleted(); }
+
+	/** Result of the next file, waits for it if it is still being decoded */
+	ResultType& GetNext()
+	{
+		check(!IsDone());
+		return Tasks[NextFile].GetResult();
+	}
+
+	/** Lets go of the next file's result and launches the files that now fit */
+	void PopNext()
+	{
+		check(!IsDone());
+		Tasks[NextFile] = UE::Tasks::TTask<ResultType>();
+		NextFile++;
+		LaunchTasks();
+	}
+
+private:
+	void LaunchTasks()
+	{
+		while (Tasks.Num() < NumFiles && Tasks.Num() < NextFile + MaxInFlight)
+		{
+			Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [Decode = Decode, FileIndex = Tasks.Num()]
+			{
+				return (*Decode)(FileIndex);
+			}));
+		}
+	}
+
+	TSharedRef<FDecodeFunc> Decode;
+	TArray<UE::Tasks::TTask<ResultType>> Tasks;
+	int32 NumFiles = 0;
+	int32 MaxInFlight = 1;
+	int32 NextFile = 0;
+};
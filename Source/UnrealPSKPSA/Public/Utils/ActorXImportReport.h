@@ -0,0 +1,61 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Readers/ActorXTrace.h"
+
+/**
+ * Timing summary of a single import. Every phase is also a CPU scope on the ActorX trace channel,
+ * the summary is written as JSON when ActorX.ImportReport is set so import cost can be tracked per asset.
+ * Memory is the process' physical memory use, so files imported at the same time show up in each other's numbers.
+ */
+class UNREALPSKPSA_API FActorXImportReport
+{
+public:
+	explicit FActorXImportReport(const FString& InSourceFile);
+
+	/**
+	 * Times consecutive phases of an import, Next ends the current phase and starts the following one.
+	 * The report can be null so the creation functions can be used without one.
+	 */
+	class UNREALPSKPSA_API FPhase
+	{
+	public:
+		FPhase(FActorXImportReport* InReport, const TCHAR* InName);
+		~FPhase();
+
+		void Next(const TCHAR* InName);
+
+	private:
+		void Begin(const TCHAR* InName);
+		void End();
+
+		FActorXImportReport* Report;
+		const TCHAR* Name = nullptr;
+		uint64 StartCycles = 0;
+		bool bTraced = false;
+	};
+
+	void AddPhase(const FString& Name, double Seconds);
+	void AddChunks(TConstArrayView<FActorXChunkStats> Chunks);
+	void AddCount(const FString& Name, int64 Count);
+	void AddMetric(const FString& Name, double Value);
+	void SetAsset(const UObject* Asset);
+
+	/** Keeps the highest physical memory use seen so far, every phase samples it when it ends */
+	void SampleMemory();
+
+	/** Writes the report to ActorX.ImportReportDir if reports are enabled */
+	void Save() const;
+
+	static bool IsEnabled();
+
+private:
+	FString SourceFile;
+	FString AssetPath;
+	FString AssetClass;
+	TArray<TPair<FString, double>> Phases;
+	TArray<TPair<FString, int64>> Counts;
+	TArray<TPair<FString, double>> Metrics;
+	TArray<FActorXChunkStats> ChunkStats;
+	uint64 StartUsedPhysical = 0;
+	uint64 PeakUsedPhysical = 0;
+};
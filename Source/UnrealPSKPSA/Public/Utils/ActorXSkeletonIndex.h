@@ -0,0 +1,49 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class USkeleton;
+struct FReferenceSkeleton;
+
+/** How a mesh's bones relate to an existing skeleton */
+enum class EActorXSkeletonMatch : uint8
+{
+	None,
+	/** Same bones, parents and reference pose */
+	Exact,
+	/** Every bone of the mesh is in the skeleton, the skeleton can be used as it is */
+	Subset,
+	/** The mesh adds bones to everything the skeleton has, they have to be merged into it */
+	Superset,
+};
+
+/**
+ * Finds skeletons an imported mesh can share instead of getting its own. Every skeleton is tagged in the asset registry
+ * with a fingerprint of its bone names, parents and reference pose, with its root bone, its bone count and a bloom filter of its bone names,
+ * so candidates are found without loading every skeleton of the project. Skeletons saved before the plugin was loaded are tagged the next time they are saved.
+ */
+class UNREALPSKPSA_API FActorXSkeletonIndex
+{
+public:
+	/** Adds the registry tags to skeletons, called when the module starts */
+	static void Register();
+	static void Unregister();
+
+	static uint64 Fingerprint(const FReferenceSkeleton& RefSkeleton);
+
+	/** Compares the shared bones by parent and local reference pose */
+	static EActorXSkeletonMatch Match(const FReferenceSkeleton& MeshSkeleton, const FReferenceSkeleton& Skeleton);
+
+	/**
+	 * Finds the best skeleton for the bones of a mesh, an exact match first, then one it fits in, then one it extends.
+	 * Only skeletons in the project's own writable content are extended, engine and plugin skeletons are never merged into.
+	 */
+	static USkeleton* FindCompatible(const FReferenceSkeleton& MeshSkeleton, EActorXSkeletonMatch& OutMatch);
+
+	/** Refreshes the registry tags of a skeleton whose bones changed in memory, so the next imports of a batch see them before it is saved */
+	static void UpdateTags(const USkeleton* Skeleton);
+
+	static const FName FingerprintTag;
+	static const FName RootBoneTag;
+	static const FName BoneCountTag;
+	static const FName BoneSetTag;
+};
@@ -1,9 +1,42 @@
 #pragma once
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+
+class FActorXImportReport;
+class PSKReader;
+class UPSKImportOptions;
 
 class FActorXUtils
 {
 public:
+	/**
+	 * Flags for the ParallelFor loops converting meshes. Every iteration writes its own elements, so the result is the same either way,
+	 * ActorX.SerialMeshConversion runs them on the calling thread to compare against.
+	 */
+	static EParallelForFlags GetConversionFlags();
+
+	/**
+	 * Start of building a mesh out of a reader: converts it, merges its materials and returns the piece hashes.
+	 * Readers coming from the parse cache are already converted. Merging comes before hashing so the hashes match the ones a reimport computes,
+	 * and hashing comes before the geometry is moved out of the reader.
+	 */
+	static TMap<FName, uint64> PrepareMesh(PSKReader& Data, const UPSKImportOptions* Options, FActorXImportReport* Report);
+
+	/**
+	 * Vertex color of every point, empty if the file has none. Both mesh types keep one color per point.
+	 * Several wedges can share a point and the last one wins, so this stays serial to keep the result deterministic.
+	 */
+	static TArray<FColor> GetVertexColorsByPoint(const PSKReader& Data);
+
+	/**
+	 * Orders faces for the vertex cache through FActorXVertexCache, CornerWedges holds the three wedges of every face as the build gets them.
+	 * OutOrder gets the face at every new position, the ACMR of the file's order and of the new one goes to the report.
+	 * Both are measured on the faces handed to the build, see AddBuiltACMR for the order the engine ends up drawing.
+	 */
+	static void OptimizeFaceOrder(TConstArrayView<int32> CornerWedges, TConstArrayView<int32> Sections, TArray<int32>& OutOrder, FActorXImportReport* Report);
+
+	/** Reports the ACMR of the index buffer the mesh build produced as ACMRBuilt, the build may split vertices and reorder triangles again */
+	static void AddBuiltACMR(TConstArrayView<uint32> Indices, FActorXImportReport* Report);
 	
 	template <typename T>
 	static T* LocalFindOrCreate(UClass* StaticClass, UObject* FactoryParent, FString Filename, EObjectFlags Flags)
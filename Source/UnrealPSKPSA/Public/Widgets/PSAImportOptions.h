@@ -20,5 +20,8 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Import Settings", meta = (ToolTip = "Specifies whether or not to put the sequences in a folder with the PSA name"))
 		bool bCreateFolder;
 
+	UPROPERTY(EditAnywhere, Category = "Import Settings", meta = (ToolTip = "Whether or not to load the properties exported by UModel"))
+		bool bLoadProperties;
+
 	bool bInitialized;
 };
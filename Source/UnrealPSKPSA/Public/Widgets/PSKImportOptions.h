@@ -23,6 +23,27 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Import Settings|Properties|Skeletal Mesh", meta = (EditCondition = "bSkeletalMesh && bLoadProperties"))
 	bool bCreateSockets;
 
+	UPROPERTY(EditAnywhere, Category = "Import Settings|Skinning", meta = (EditCondition = "bSkeletalMesh", EditConditionHides, ToolTip = "Bind to an existing skeleton with the same bones instead of creating a new one"))
+	bool bReuseSkeleton;
+
+	UPROPERTY(EditAnywhere, Category = "Import Settings", meta = (ToolTip = "Merge wedges with the same point, material and UVs before the mesh is built"))
+	bool bWeldWedges;
+
+	UPROPERTY(EditAnywhere, Category = "Import Settings", meta = (EditCondition = "bWeldWedges", ClampMin = "0", ToolTip = "Corners whose UVs differ by at most this on each axis are welded, 0 only welds identical UVs"))
+	float WeldUVTolerance;
+
+	UPROPERTY(EditAnywhere, Category = "Import Settings", meta = (ToolTip = "Reorder the triangles of every material for the GPU's vertex cache"))
+	bool bOptimizeVertexCache;
+
+	UPROPERTY(EditAnywhere, Category = "Import Settings", meta = (ToolTip = "Merge material slots with the same name into one section to cut draw calls"))
+	bool bMergeMaterials;
+
+	UPROPERTY(EditAnywhere, Category = "Import Settings|Skinning", meta = (EditCondition = "bSkeletalMesh", EditConditionHides, ClampMin = "1", ClampMax = "12", ToolTip = "Most bones a vertex is skinned to, the weakest influences are dropped"))
+	int32 MaxBoneInfluences;
+
+	UPROPERTY(EditAnywhere, Category = "Import Settings|Skinning", meta = (EditCondition = "bSkeletalMesh", EditConditionHides, ClampMin = "0", ClampMax = "1", ToolTip = "Influences weaker than this are dropped before the weights are renormalised"))
+	float BoneInfluenceThreshold;
+
 	//UPROPERTY(EditAnywhere, Category = "Import Settings|Properties|Static Mesh", meta = (EditCondition = "!bSkeletalMesh && bLoadProperties", EditConditionHides))
 
 	// Used to influence other properties, it has no other purpose for importing.
@@ -25,7 +25,9 @@ public class UnrealPSKPSA : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Core"
+				"Core",
+				// ActorXImportReport.h includes the reader trace header
+				"UnrealPSKPSAReaders"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -44,11 +46,16 @@ public class UnrealPSKPSA : ModuleRules
 				"MeshDescription",
                 "ToolWidgets",
 
-                "RawMesh",
+                "StaticMeshDescription",
 				"RenderCore",
 				"MeshBuilder",
 				"MeshUtilitiesCommon", 
 				"EditorScriptingUtilities",
+				"Json",
+				"JsonUtilities",
+				"ToolMenus",
+				"ContentBrowser",
+				"DesktopPlatform",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
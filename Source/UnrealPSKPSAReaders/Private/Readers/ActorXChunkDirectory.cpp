@@ -0,0 +1,55 @@
+#include "Readers/ActorXChunkDirectory.h"
+#include "UnrealPSKPSAReaders.h"
+#include "Readers/ActorXTrace.h"
+
+bool FActorXChunkDirectory::Open(const FString& Filename, uint64 HeaderId)
+{
+	ACTORX_TRACE_SCOPE("ActorX.IndexChunks");
+	Close();
+
+	if (!File.Open(Filename))
+	{
+		return false;
+	}
+
+	int64 Offset = 0;
+	FActorXChunkView Header;
+	if (!File.NextChunk(Offset, Header) || !Header.Is(HeaderId))
+	{
+		UE_LOG(LogActorXReader, Error, TEXT("%s is not a valid ActorX file"), *Filename);
+		Close();
+		return false;
+	}
+
+	FActorXChunkView Chunk;
+	while (File.NextChunk(Offset, Chunk))
+	{
+		Chunks.Add(Chunk);
+	}
+
+	DecodedChunks.Init(false, Chunks.Num());
+	return true;
+}
+
+void FActorXChunkDirectory::Close()
+{
+	Chunks.Empty();
+	DecodedChunks.Empty();
+	File.Close();
+}
+
+const FActorXChunkView* FActorXChunkDirectory::Find(uint64 ChunkId) const
+{
+	return Chunks.FindByPredicate([ChunkId](const FActorXChunkView& Chunk) { return Chunk.Is(ChunkId); });
+}
+
+bool FActorXChunkDirectory::MarkDecoded(int32 ChunkIndex)
+{
+	if (DecodedChunks[ChunkIndex])
+	{
+		return false;
+	}
+
+	DecodedChunks[ChunkIndex] = true;
+	return true;
+}
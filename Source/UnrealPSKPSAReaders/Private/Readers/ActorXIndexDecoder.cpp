@@ -0,0 +1,204 @@
+#include "Readers/ActorXIndexDecoder.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#include <arm_neon.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+#include <emmintrin.h>
+#endif
+
+// The vector paths store a whole register over the indices, the material bytes and the padding after them
+static_assert(sizeof(VTriangle) == 20 && STRUCT_OFFSET(VTriangle, MatIndex) == 12 && STRUCT_OFFSET(VTriangle, SmoothingGroups) == 16, "Unexpected VTriangle layout");
+static_assert(sizeof(VVertex) == 16, "Unexpected VVertex layout");
+
+bool FActorXIndexDecoder::DecodeFaces16(const FActorXChunkView& Chunk, int32 NumWedges, TArray<VTriangle>& OutFaces)
+{
+	if (Chunk.DataSize < Face16RecordSize)
+		return false;
+
+	const auto NumFaces = Chunk.DataCount;
+	OutFaces.SetNumUninitialized(NumFaces);
+	if (NumFaces > 0 && NumWedges <= 0)
+		return false;
+
+	auto Faces = OutFaces.GetData();
+	auto bValid = true;
+	auto i = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	// Word 3 holds MatIndex and AuxMatIndex, widening it lines them up with VTriangle's layout
+	const uint32 MaxWedge = NumWedges - 1;
+	const uint32x4_t Limit = { MaxWedge, MaxWedge, MaxWedge, MAX_uint32 };
+	auto OutOfRange = vdupq_n_u32(0);
+	for (; i < NumFaces; i++)
+	{
+		const auto Src = Chunk.GetRecord(i);
+		const auto Wide = vmovl_u16(vld1_u16(reinterpret_cast<const uint16*>(Src)));
+		vst1q_u32(reinterpret_cast<uint32*>(&Faces[i]), Wide);
+		FMemory::Memcpy(&Faces[i].SmoothingGroups, Src + 8, sizeof(unsigned));
+
+		OutOfRange = vorrq_u32(OutOfRange, vcgtq_u32(Wide, Limit));
+	}
+	bValid = vmaxvq_u32(OutOfRange) == 0;
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+	// Each record is loaded 16 bytes at a time, the last few are left to the scalar loop so we never read past the chunk
+	const auto NumVectorFaces = Chunk.GetDataBytes() >= 16 ? FMath::Min<int64>(NumFaces, (Chunk.GetDataBytes() - 16) / Chunk.DataSize + 1) : 0;
+
+	// Word 3 holds MatIndex and AuxMatIndex, widening it lines them up with VTriangle's layout
+	const auto Zero = _mm_setzero_si128();
+	const auto Limit = _mm_setr_epi32(NumWedges - 1, NumWedges - 1, NumWedges - 1, MAX_int32);
+	auto OutOfRange = Zero;
+	for (; i < NumVectorFaces; i++)
+	{
+		const auto Src = Chunk.GetRecord(i);
+		const auto Wide = _mm_unpacklo_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Src)), Zero);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&Faces[i]), Wide);
+		FMemory::Memcpy(&Faces[i].SmoothingGroups, Src + 8, sizeof(unsigned));
+
+		OutOfRange = _mm_or_si128(OutOfRange, _mm_cmpgt_epi32(Wide, Limit));
+	}
+	bValid = _mm_movemask_epi8(OutOfRange) == 0;
+#endif
+
+	for (; i < NumFaces; i++)
+	{
+		FActorXRecordCursor Cursor(Chunk.GetRecord(i));
+		for (auto j = 0; j < 3; j++)
+		{
+			uint16 WedgeIndex;
+			Cursor.Read(WedgeIndex);
+			Faces[i].WedgeIndex[j] = WedgeIndex;
+			bValid &= WedgeIndex < NumWedges;
+		}
+
+		Cursor.Read(Faces[i].MatIndex);
+		Cursor.Read(Faces[i].AuxMatIndex);
+		Cursor.Read(Faces[i].SmoothingGroups);
+	}
+
+	return bValid;
+}
+
+bool FActorXIndexDecoder::DecodeFaces32(const FActorXChunkView& Chunk, int32 NumWedges, TArray<VTriangle>& OutFaces)
+{
+	if (Chunk.DataSize < Face32RecordSize)
+		return false;
+
+	const auto NumFaces = Chunk.DataCount;
+	OutFaces.SetNumUninitialized(NumFaces);
+	if (NumFaces > 0 && NumWedges <= 0)
+		return false;
+
+	auto Faces = OutFaces.GetData();
+	auto bValid = true;
+	auto i = 0;
+
+	// Records are 18 bytes so a 16 byte load always stays inside the record, the last lane is copied over
+	// MatIndex, AuxMatIndex and the padding and left out of the range check
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	const int32x4_t Limit = { NumWedges - 1, NumWedges - 1, NumWedges - 1, MAX_int32 };
+	const uint32x4_t IndexLanes = { MAX_uint32, MAX_uint32, MAX_uint32, 0 };
+	const auto Zero = vdupq_n_s32(0);
+	auto OutOfRange = vdupq_n_u32(0);
+	for (; i < NumFaces; i++)
+	{
+		const auto Src = Chunk.GetRecord(i);
+		const auto Indices = vld1q_s32(reinterpret_cast<const int32*>(Src));
+		vst1q_s32(reinterpret_cast<int32*>(&Faces[i]), Indices);
+		FMemory::Memcpy(&Faces[i].SmoothingGroups, Src + 14, sizeof(unsigned));
+
+		const auto Invalid = vorrq_u32(vcgtq_s32(Indices, Limit), vcltq_s32(Indices, Zero));
+		OutOfRange = vorrq_u32(OutOfRange, vandq_u32(Invalid, IndexLanes));
+	}
+	bValid = vmaxvq_u32(OutOfRange) == 0;
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+	const auto Zero = _mm_setzero_si128();
+	const auto Limit = _mm_setr_epi32(NumWedges - 1, NumWedges - 1, NumWedges - 1, MAX_int32);
+	const auto IndexLanes = _mm_setr_epi32(-1, -1, -1, 0);
+	auto OutOfRange = Zero;
+	for (; i < NumFaces; i++)
+	{
+		const auto Src = Chunk.GetRecord(i);
+		const auto Indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&Faces[i]), Indices);
+		FMemory::Memcpy(&Faces[i].SmoothingGroups, Src + 14, sizeof(unsigned));
+
+		const auto Invalid = _mm_or_si128(_mm_cmpgt_epi32(Indices, Limit), _mm_cmplt_epi32(Indices, Zero));
+		OutOfRange = _mm_or_si128(OutOfRange, _mm_and_si128(Invalid, IndexLanes));
+	}
+	bValid = _mm_movemask_epi8(OutOfRange) == 0;
+#endif
+
+	for (; i < NumFaces; i++)
+	{
+		FActorXRecordCursor Cursor(Chunk.GetRecord(i));
+		Cursor.Read(Faces[i].WedgeIndex);
+		Cursor.Read(Faces[i].MatIndex);
+		Cursor.Read(Faces[i].AuxMatIndex);
+		Cursor.Read(Faces[i].SmoothingGroups);
+
+		for (auto j = 0; j < 3; j++)
+		{
+			bValid &= Faces[i].WedgeIndex[j] >= 0 && Faces[i].WedgeIndex[j] < NumWedges;
+		}
+	}
+
+	return bValid;
+}
+
+bool FActorXIndexDecoder::DecodeWedges(const FActorXChunkView& Chunk, int32 NumPoints, TArray<VVertex>& OutWedges)
+{
+	if (!Chunk.CopyTo(OutWedges))
+		return false;
+
+	if (OutWedges.Num() > 0 && NumPoints <= 0)
+		return false;
+
+	// Small meshes only store 16 bit point indices, the upper half is garbage
+	const int32 PointMask = Chunk.DataCount <= 65536 ? 0xFFFF : -1;
+	auto bValid = true;
+	auto i = 0;
+
+	// One wedge fills a register, only the point index lane is masked and checked
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	const int32x4_t Mask = { PointMask, -1, -1, -1 };
+	const int32x4_t Limit = { NumPoints - 1, MAX_int32, MAX_int32, MAX_int32 };
+	const uint32x4_t IndexLane = { MAX_uint32, 0, 0, 0 };
+	const auto Zero = vdupq_n_s32(0);
+	auto OutOfRange = vdupq_n_u32(0);
+	for (; i < OutWedges.Num(); i++)
+	{
+		const auto WedgePtr = reinterpret_cast<int32*>(&OutWedges[i]);
+		const auto Masked = vandq_s32(vld1q_s32(WedgePtr), Mask);
+		vst1q_s32(WedgePtr, Masked);
+
+		const auto Invalid = vorrq_u32(vcgtq_s32(Masked, Limit), vcltq_s32(Masked, Zero));
+		OutOfRange = vorrq_u32(OutOfRange, vandq_u32(Invalid, IndexLane));
+	}
+	bValid = vmaxvq_u32(OutOfRange) == 0;
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+	const auto Zero = _mm_setzero_si128();
+	const auto Mask = _mm_setr_epi32(PointMask, -1, -1, -1);
+	const auto Limit = _mm_setr_epi32(NumPoints - 1, MAX_int32, MAX_int32, MAX_int32);
+	const auto IndexLane = _mm_setr_epi32(-1, 0, 0, 0);
+	auto OutOfRange = Zero;
+	for (; i < OutWedges.Num(); i++)
+	{
+		const auto WedgePtr = reinterpret_cast<__m128i*>(&OutWedges[i]);
+		const auto Masked = _mm_and_si128(_mm_loadu_si128(WedgePtr), Mask);
+		_mm_storeu_si128(WedgePtr, Masked);
+
+		const auto Invalid = _mm_or_si128(_mm_cmpgt_epi32(Masked, Limit), _mm_cmplt_epi32(Masked, Zero));
+		OutOfRange = _mm_or_si128(OutOfRange, _mm_and_si128(Invalid, IndexLane));
+	}
+	bValid = _mm_movemask_epi8(OutOfRange) == 0;
+#endif
+
+	for (; i < OutWedges.Num(); i++)
+	{
+		auto& Wedge = OutWedges[i];
+		Wedge.PointIndex &= PointMask;
+		bValid &= Wedge.PointIndex >= 0 && Wedge.PointIndex < NumPoints;
+	}
+
+	return bValid;
+}
@@ -0,0 +1,93 @@
+#include "Readers/ActorXMappedFile.h"
+#include "UnrealPSKPSAReaders.h"
+#include "Readers/ActorXTrace.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+// On-disk chunk header, 20 byte id followed by the type flag, record size and record count
+static constexpr int64 ChunkHeaderSize = 32;
+
+FActorXMappedFile::FActorXMappedFile() = default;
+
+FActorXMappedFile::~FActorXMappedFile()
+{
+	Close();
+}
+
+bool FActorXMappedFile::Open(const FString& Filename)
+{
+	ACTORX_TRACE_SCOPE("ActorX.MapFile");
+	Close();
+
+	MappedHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (MappedHandle.IsValid() && MappedHandle->GetFileSize() > 0)
+	{
+		MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+	}
+
+	if (MappedRegion.IsValid())
+	{
+		Data = MappedRegion->GetMappedPtr();
+		Size = MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		// Mapping isn't supported everywhere, fall back to a single read of the whole file
+		MappedHandle.Reset();
+		if (!FFileHelper::LoadFileToArray(LoadedData, *Filename) || LoadedData.IsEmpty())
+		{
+			UE_LOG(LogActorXReader, Error, TEXT("Failed to open ActorX file: %s"), *Filename);
+			return false;
+		}
+
+		Data = LoadedData.GetData();
+		Size = LoadedData.Num();
+	}
+
+	return true;
+}
+
+void FActorXMappedFile::Close()
+{
+	// The region has to go before the handle it was mapped from
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	LoadedData.Empty();
+
+	Data = nullptr;
+	Size = 0;
+}
+
+bool FActorXMappedFile::NextChunk(int64& Offset, FActorXChunkView& OutChunk) const
+{
+	if (!IsOpen() || Offset + ChunkHeaderSize > Size)
+	{
+		return false;
+	}
+
+	FActorXRecordCursor Cursor(Data + Offset);
+	Cursor.Read(OutChunk.ChunkID);
+	Cursor.Read(OutChunk.TypeFlag);
+	Cursor.Read(OutChunk.DataSize);
+	Cursor.Read(OutChunk.DataCount);
+	OutChunk.Id = ActorXChunkId(OutChunk.ChunkID);
+	OutChunk.Offset = Offset + ChunkHeaderSize;
+	OutChunk.Data = Cursor.Ptr;
+
+	if (OutChunk.DataSize < 0 || OutChunk.DataCount < 0)
+	{
+		UE_LOG(LogActorXReader, Error, TEXT("Invalid ActorX chunk %hs at offset %lld"), OutChunk.ChunkID, Offset);
+		return false;
+	}
+
+	const auto ChunkEnd = Offset + ChunkHeaderSize + OutChunk.GetDataBytes();
+	if (ChunkEnd > Size)
+	{
+		UE_LOG(LogActorXReader, Warning, TEXT("Truncated ActorX chunk %hs at offset %lld"), OutChunk.ChunkID, Offset);
+		return false;
+	}
+
+	Offset = ChunkEnd;
+	return true;
+}
@@ -0,0 +1,456 @@
+#include "Readers/ActorXParseCache.h"
+#include "UnrealPSKPSAReaders.h"
+#include "Readers/ActorXTrace.h"
+#include "Readers/PSAReader.h"
+#include "Readers/PSKReader.h"
+#include "Async/ParallelFor.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include <type_traits>
+
+static TAutoConsoleVariable<bool> CVarActorXParseCache(
+	TEXT("ActorX.ParseCache"),
+	true,
+	TEXT("Cache the converted data of imported ActorX files so reimporting an unchanged file skips reading and converting it."));
+
+static TAutoConsoleVariable<FString> CVarActorXParseCacheDir(
+	TEXT("ActorX.ParseCacheDir"),
+	TEXT(""),
+	TEXT("Directory the ActorX parse cache is kept in, defaults to Saved/ActorXParseCache."));
+
+static TAutoConsoleVariable<int32> CVarActorXParseCacheMaxSizeMB(
+	TEXT("ActorX.ParseCacheMaxSizeMB"),
+	2048,
+	TEXT("Size the ActorX parse cache is trimmed to whenever an entry is added, least recently used entries go first. 0 doesn't limit it."));
+
+// "AXPC"
+static constexpr uint32 CacheMagic = 0x43505841;
+
+enum class EActorXCacheKind : uint32
+{
+	Mesh = 1,
+	Anim = 2
+};
+
+struct FActorXCacheHeader
+{
+	uint32 Magic = CacheMagic;
+	uint32 Version = FActorXParseCache::ReaderVersion;
+	EActorXCacheKind Kind = EActorXCacheKind::Mesh;
+};
+
+/** Bounds checked reads out of a mapped entry, a truncated or foreign file makes them fail instead of reading past the end */
+struct FActorXCacheCursor
+{
+	FActorXCacheCursor(const uint8* InPtr, const uint8* InEnd) : Ptr(InPtr), End(InEnd) {}
+
+	template <typename T>
+	bool Read(T& Out)
+	{
+		if (End - Ptr < static_cast<int64>(sizeof(T)))
+			return false;
+
+		FMemory::Memcpy(&Out, Ptr, sizeof(T));
+		Ptr += sizeof(T);
+		return true;
+	}
+
+	template <typename T>
+	bool ReadArray(TArray<T>& Out, int32 Num)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Only plain-old-data can be cached");
+		if (Num < 0 || (End - Ptr) / static_cast<int64>(sizeof(T)) < Num)
+			return false;
+
+		Out.SetNumUninitialized(Num);
+		FMemory::Memcpy(Out.GetData(), Ptr, Num * sizeof(T));
+		Ptr += Num * sizeof(T);
+		return true;
+	}
+
+	template <typename T>
+	bool ReadArray(TArray<T>& Out)
+	{
+		int32 Num;
+		return Read(Num) && ReadArray(Out, Num);
+	}
+
+	bool ReadHeader(EActorXCacheKind Kind)
+	{
+		FActorXCacheHeader Header;
+		return Read(Header) && Header.Magic == CacheMagic && Header.Version == FActorXParseCache::ReaderVersion && Header.Kind == Kind;
+	}
+
+	const uint8* Ptr;
+	const uint8* End;
+};
+
+template <typename T>
+static void WriteArrayData(FArchive& Ar, const TArray<T>& Array)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "Only plain-old-data can be cached");
+	Ar.Serialize(const_cast<T*>(Array.GetData()), Array.Num() * sizeof(T));
+}
+
+template <typename T>
+static void WriteArray(FArchive& Ar, const TArray<T>& Array)
+{
+	auto Num = Array.Num();
+	Ar << Num;
+	WriteArrayData(Ar, Array);
+}
+
+static void WriteHeader(FArchive& Ar, EActorXCacheKind Kind)
+{
+	FActorXCacheHeader Header;
+	Header.Kind = Kind;
+	Ar.Serialize(&Header, sizeof(Header));
+}
+
+/** Entries are written to a unique temporary file and then moved into place, so readers never see a partial entry */
+static TUniquePtr<FArchive> CreateEntryWriter(const FString& Key, FString& OutTempFile)
+{
+	OutTempFile = FActorXParseCache::GetEntryFilename(Key) + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+	return TUniquePtr<FArchive>(IFileManager::Get().CreateFileWriter(*OutTempFile, FILEWRITE_Silent));
+}
+
+static void DiscardEntry(TUniquePtr<FArchive> Writer, const FString& TempFile)
+{
+	Writer.Reset();
+	IFileManager::Get().Delete(*TempFile, false, false, true);
+}
+
+/**
+ * Deletes the least recently used entries until the cache fits in ActorX.ParseCacheMaxSizeMB.
+ * Hits touch their entry, so the modification time is when it was last used. Entries that are still mapped can't be deleted and are skipped.
+ */
+static void TrimCache()
+{
+	const auto MaxBytes = static_cast<int64>(CVarActorXParseCacheMaxSizeMB.GetValueOnAnyThread()) * 1024 * 1024;
+	if (MaxBytes <= 0)
+		return;
+
+	ACTORX_TRACE_SCOPE("ActorX.TrimCache");
+
+	struct FCacheEntryStat
+	{
+		FString Filename;
+		FDateTime LastUsed;
+		int64 Size;
+	};
+
+	TArray<FCacheEntryStat> Entries;
+	auto TotalBytes = 0ll;
+	IFileManager::Get().IterateDirectoryStat(*FPaths::GetPath(FActorXParseCache::GetEntryFilename(TEXT("Entry"))), [&](const TCHAR* Filename, const FFileStatData& Stat)
+	{
+		if (!Stat.bIsDirectory && FPaths::GetExtension(Filename) == TEXT("axcache"))
+		{
+			Entries.Add({ Filename, Stat.ModificationTime, Stat.FileSize });
+			TotalBytes += Stat.FileSize;
+		}
+		return true;
+	});
+
+	if (TotalBytes <= MaxBytes)
+		return;
+
+	Entries.Sort([](const FCacheEntryStat& A, const FCacheEntryStat& B) { return A.LastUsed < B.LastUsed; });
+	for (const auto& Entry : Entries)
+	{
+		if (TotalBytes <= MaxBytes)
+			break;
+
+		if (IFileManager::Get().Delete(*Entry.Filename, false, false, true))
+		{
+			TotalBytes -= Entry.Size;
+		}
+	}
+}
+
+static bool CommitEntry(const FString& Key, TUniquePtr<FArchive> Writer, const FString& TempFile)
+{
+	const auto bWritten = Writer->Close() && !Writer->IsError();
+
+	// Another import of the same file may have committed the entry first, either copy is fine
+	if (!bWritten || !IFileManager::Get().Move(*FActorXParseCache::GetEntryFilename(Key), *TempFile, true, true, false, true))
+	{
+		DiscardEntry(MoveTemp(Writer), TempFile);
+		return false;
+	}
+
+	Writer.Reset();
+	TrimCache();
+	return true;
+}
+
+/** Marks an entry as used so trimming the cache keeps it over entries that haven't been hit for longer */
+static void TouchEntry(const FString& EntryFile)
+{
+	IFileManager::Get().SetTimeStamp(*EntryFile, FDateTime::UtcNow());
+}
+
+static void ResetMesh(PSKReader& Reader)
+{
+	Reader.Vertices.Reset();
+	Reader.Wedges.Reset();
+	Reader.Faces.Reset();
+	Reader.Materials.Reset();
+	Reader.Normals.Reset();
+	Reader.VertexColors.Reset();
+	Reader.ExtraUVs.Reset();
+	Reader.Bones.Reset();
+	Reader.Influences.Reset();
+}
+
+bool FActorXParseCache::IsEnabled()
+{
+	return CVarActorXParseCache.GetValueOnAnyThread();
+}
+
+FString FActorXParseCache::MakeKey(const FString& Filename)
+{
+	ACTORX_TRACE_SCOPE("ActorX.HashFile");
+
+	FActorXMappedFile File;
+	if (!File.Open(Filename))
+		return FString();
+
+	const auto Version = ReaderVersion;
+	FXxHash64Builder Builder;
+	Builder.Update(&Version, sizeof(Version));
+	Builder.Update(File.GetData(), File.GetSize());
+
+	return FString::Printf(TEXT("%016llx"), Builder.Finalize().Hash);
+}
+
+FString FActorXParseCache::GetEntryFilename(const FString& Key)
+{
+	auto CacheDir = CVarActorXParseCacheDir.GetValueOnAnyThread();
+	if (CacheDir.IsEmpty())
+	{
+		CacheDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ActorXParseCache"));
+	}
+
+	return FPaths::Combine(CacheDir, Key + TEXT(".axcache"));
+}
+
+bool FActorXParseCache::LoadMesh(const FString& Key, PSKReader& Reader)
+{
+	const auto EntryFile = GetEntryFilename(Key);
+	if (Key.IsEmpty() || !FPaths::FileExists(EntryFile))
+		return false;
+
+	ACTORX_TRACE_SCOPE("ActorX.LoadCache");
+
+	FActorXMappedFile File;
+	if (!File.Open(EntryFile))
+		return false;
+
+	FActorXCacheCursor Cursor(File.GetData(), File.GetData() + File.GetSize());
+	auto bValid = Cursor.ReadHeader(EActorXCacheKind::Mesh)
+		&& Cursor.ReadArray(Reader.Vertices)
+		&& Cursor.ReadArray(Reader.Wedges)
+		&& Cursor.ReadArray(Reader.Faces)
+		&& Cursor.ReadArray(Reader.Materials)
+		&& Cursor.ReadArray(Reader.Normals)
+		&& Cursor.ReadArray(Reader.VertexColors);
+
+	int32 NumExtraUVs = 0;
+	bValid = bValid && Cursor.Read(NumExtraUVs) && NumExtraUVs >= 0 && NumExtraUVs < ActorXMaxUVSets;
+	if (bValid)
+	{
+		Reader.ExtraUVs.SetNum(NumExtraUVs);
+		for (auto& UVs : Reader.ExtraUVs)
+		{
+			bValid = bValid && Cursor.ReadArray(UVs);
+		}
+	}
+
+	bValid = bValid
+		&& Cursor.ReadArray(Reader.Bones)
+		&& Cursor.ReadArray(Reader.Influences)
+		&& Cursor.Read(Reader.Bounds);
+
+	if (!bValid)
+	{
+		UE_LOG(LogActorXReader, Warning, TEXT("Ignoring the invalid cache entry %s"), *EntryFile);
+		ResetMesh(Reader);
+		return false;
+	}
+
+	TouchEntry(EntryFile);
+	return true;
+}
+
+bool FActorXParseCache::SaveMesh(const FString& Key, const PSKReader& Reader)
+{
+	ACTORX_TRACE_SCOPE("ActorX.SaveCache");
+
+	FString TempFile;
+	auto Writer = CreateEntryWriter(Key, TempFile);
+	if (!Writer)
+		return false;
+
+	auto& Ar = *Writer;
+	WriteHeader(Ar, EActorXCacheKind::Mesh);
+	WriteArray(Ar, Reader.Vertices);
+	WriteArray(Ar, Reader.Wedges);
+	WriteArray(Ar, Reader.Faces);
+	WriteArray(Ar, Reader.Materials);
+	WriteArray(Ar, Reader.Normals);
+	WriteArray(Ar, Reader.VertexColors);
+
+	auto NumExtraUVs = Reader.ExtraUVs.Num();
+	Ar << NumExtraUVs;
+	for (const auto& UVs : Reader.ExtraUVs)
+	{
+		WriteArray(Ar, UVs);
+	}
+
+	WriteArray(Ar, Reader.Bones);
+	WriteArray(Ar, Reader.Influences);
+
+	auto Bounds = Reader.Bounds;
+	Ar.Serialize(&Bounds, sizeof(Bounds));
+
+	return CommitEntry(Key, MoveTemp(Writer), TempFile);
+}
+
+bool FActorXParseCache::SaveAnim(const FString& Key, const PSAReader& Reader)
+{
+	ACTORX_TRACE_SCOPE("ActorX.SaveCache");
+
+	FString TempFile;
+	auto Writer = CreateEntryWriter(Key, TempFile);
+	if (!Writer)
+		return false;
+
+	auto& Ar = *Writer;
+	WriteHeader(Ar, EActorXCacheKind::Anim);
+	WriteArray(Ar, Reader.AnimInfo);
+	WriteArray(Ar, Reader.Bones);
+
+	auto NumBones = Reader.GetNumBones();
+	Ar << NumBones;
+
+	// Every sequence starts at an offset from the table, it is filled in once the sequences are written
+	const auto NumSequences = Reader.AnimInfo.Num();
+	TArray<int64> SequenceOffsets;
+	SequenceOffsets.SetNumZeroed(NumSequences);
+	const auto TableOffset = Ar.Tell();
+	WriteArrayData(Ar, SequenceOffsets);
+
+	const auto BatchSize = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	TArray<TArray<FPSABoneTrack>> BatchTracks;
+	TArray<bool> BatchDecoded;
+	for (auto BatchStart = 0; BatchStart < NumSequences; BatchStart += BatchSize)
+	{
+		const auto BatchCount = FMath::Min(BatchSize, NumSequences - BatchStart);
+		BatchTracks.Reset();
+		BatchTracks.SetNum(BatchCount);
+		BatchDecoded.SetNumZeroed(BatchCount);
+
+		ParallelFor(BatchCount, [&](int32 BatchIndex)
+		{
+			BatchDecoded[BatchIndex] = Reader.ReadSequenceTracks(Reader.AnimInfo[BatchStart + BatchIndex], BatchTracks[BatchIndex]);
+			PSAReader::ConvertTracks(BatchTracks[BatchIndex]);
+		});
+
+		// An entry with a sequence that couldn't be decoded would be read back as valid, so none is written
+		if (BatchDecoded.Contains(false))
+		{
+			UE_LOG(LogActorXReader, Warning, TEXT("Not caching %s, one of its sequences couldn't be decoded"), *Reader.GetFileName());
+			DiscardEntry(MoveTemp(Writer), TempFile);
+			return false;
+		}
+
+		for (auto BatchIndex = 0; BatchIndex < BatchCount; BatchIndex++)
+		{
+			const auto& Tracks = BatchTracks[BatchIndex];
+			SequenceOffsets[BatchStart + BatchIndex] = Ar.Tell();
+
+			auto NumFrames = Tracks.IsEmpty() ? 0 : Tracks[0].PositionalKeys.Num();
+			Ar << NumFrames;
+			for (const auto& Track : Tracks)
+			{
+				WriteArrayData(Ar, Track.PositionalKeys);
+				WriteArrayData(Ar, Track.RotationalKeys);
+				WriteArrayData(Ar, Track.ScaleKeys);
+			}
+		}
+	}
+
+	Ar.Seek(TableOffset);
+	WriteArrayData(Ar, SequenceOffsets);
+
+	return CommitEntry(Key, MoveTemp(Writer), TempFile);
+}
+
+bool FActorXAnimCacheEntry::Open(const FString& Key, TArray<VAnimInfoBinary>& OutAnimInfo, TArray<VNamedBoneBinary>& OutBones)
+{
+	Close();
+
+	const auto EntryFile = FActorXParseCache::GetEntryFilename(Key);
+	if (Key.IsEmpty() || !FPaths::FileExists(EntryFile))
+		return false;
+
+	ACTORX_TRACE_SCOPE("ActorX.LoadCache");
+
+	if (!File.Open(EntryFile))
+		return false;
+
+	FActorXCacheCursor Cursor(File.GetData(), File.GetData() + File.GetSize());
+	TArray<VAnimInfoBinary> AnimInfo;
+	TArray<VNamedBoneBinary> Bones;
+	const auto bValid = Cursor.ReadHeader(EActorXCacheKind::Anim)
+		&& Cursor.ReadArray(AnimInfo)
+		&& Cursor.ReadArray(Bones)
+		&& Cursor.Read(NumBones)
+		&& Cursor.ReadArray(SequenceOffsets, AnimInfo.Num());
+
+	if (!bValid || NumBones < 0)
+	{
+		UE_LOG(LogActorXReader, Warning, TEXT("Ignoring the invalid cache entry %s"), *EntryFile);
+		Close();
+		return false;
+	}
+
+	TouchEntry(EntryFile);
+	OutAnimInfo = MoveTemp(AnimInfo);
+	OutBones = MoveTemp(Bones);
+	return true;
+}
+
+void FActorXAnimCacheEntry::Close()
+{
+	File.Close();
+	SequenceOffsets.Reset();
+	NumBones = 0;
+}
+
+bool FActorXAnimCacheEntry::ReadTracks(int32 SequenceIndex, TArray<FPSABoneTrack>& OutTracks) const
+{
+	ACTORX_TRACE_SCOPE("ActorX.ReadCachedTracks");
+
+	OutTracks.Reset();
+	OutTracks.SetNum(NumBones);
+
+	if (!SequenceOffsets.IsValidIndex(SequenceIndex) || SequenceOffsets[SequenceIndex] < 0 || SequenceOffsets[SequenceIndex] >= File.GetSize())
+		return false;
+
+	FActorXCacheCursor Cursor(File.GetData() + SequenceOffsets[SequenceIndex], File.GetData() + File.GetSize());
+	int32 NumFrames;
+	if (!Cursor.Read(NumFrames))
+		return false;
+
+	for (auto& Track : OutTracks)
+	{
+		if (!Cursor.ReadArray(Track.PositionalKeys, NumFrames) || !Cursor.ReadArray(Track.RotationalKeys, NumFrames) || !Cursor.ReadArray(Track.ScaleKeys, NumFrames))
+			return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,335 @@
+#include "Readers/ActorXProperties.h"
+#include "UnrealPSKPSAReaders.h"
+#include "Readers/ActorXTrace.h"
+#include "Misc/FileHelper.h"
+
+// The text comes from outside the editor, so array sizes and nesting are bounded before they are trusted
+static constexpr int32 MaxPropertyIndex = 1 << 20;
+static constexpr int32 MaxPropertyDepth = 64;
+
+// Shortest element an array can hold, "a=b" and its line break, used to size arrays by the text that is left
+static constexpr int64 MinElementBytes = 4;
+
+/**
+ * Recursive descent over the UModel format:
+ *
+ * Name = Value
+ * Name = { Field=Value, Field=Value }
+ * Name[Count] =
+ * {
+ *     Name[0] = ...
+ * }
+ *
+ * Struct bodies are either written on one line with comma separated fields or as one field per line.
+ */
+class FActorXPropertyParser
+{
+public:
+	FActorXPropertyParser(const ANSICHAR* Text, int64 Length) : Ptr(Text), End(Text + Length) {}
+
+	bool ParseDocument(FActorXProperty& Root)
+	{
+		// Skip the UTF-8 byte order mark
+		if (End - Ptr >= 3 && static_cast<uint8>(Ptr[0]) == 0xEF && static_cast<uint8>(Ptr[1]) == 0xBB && static_cast<uint8>(Ptr[2]) == 0xBF)
+		{
+			Ptr += 3;
+		}
+
+		return ParseBody(Root, false) && bValid;
+	}
+
+private:
+	static bool IsBlank(ANSICHAR Char) { return Char == ' ' || Char == '\t' || Char == '\r'; }
+	static bool IsNameChar(ANSICHAR Char) { return FCharAnsi::IsAlnum(Char) || Char == '_'; }
+
+	void SkipBlanks()
+	{
+		while (Ptr < End && IsBlank(*Ptr))
+		{
+			Ptr++;
+		}
+	}
+
+	void SkipLine()
+	{
+		while (Ptr < End && *Ptr++ != '\n')
+		{
+		}
+	}
+
+	void SkipSeparators()
+	{
+		while (Ptr < End && (IsBlank(*Ptr) || *Ptr == '\n' || *Ptr == ','))
+		{
+			Ptr++;
+		}
+	}
+
+	static FString MakeString(const ANSICHAR* Start, const ANSICHAR* Stop)
+	{
+		const FUTF8ToTCHAR Converted(Start, static_cast<int32>(Stop - Start));
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	/** Parses fields until the closing brace, or until the end of the text for the root */
+	bool ParseBody(FActorXProperty& Parent, bool bBraced)
+	{
+		// A body that continues on the same line as its brace is a single line struct
+		SkipBlanks();
+		const auto bInline = bBraced && Ptr < End && *Ptr != '\n';
+
+		while (true)
+		{
+			SkipSeparators();
+			if (Ptr == End)
+			{
+				return !bBraced;
+			}
+
+			if (*Ptr == '}')
+			{
+				Ptr++;
+				return bBraced;
+			}
+
+			// Lines that can't be parsed are skipped so one bad line doesn't lose the rest of the file
+			if (!ParseField(Parent, bInline))
+			{
+				bValid = false;
+				SkipLine();
+			}
+		}
+	}
+
+	bool ParseField(FActorXProperty& Parent, bool bInline)
+	{
+		const auto NameStart = Ptr;
+		while (Ptr < End && IsNameChar(*Ptr))
+		{
+			Ptr++;
+		}
+
+		if (Ptr == NameStart)
+		{
+			return false;
+		}
+		const auto NameEnd = Ptr;
+
+		auto Index = INDEX_NONE;
+		SkipBlanks();
+		if (Ptr < End && *Ptr == '[')
+		{
+			Ptr++;
+			Index = 0;
+			while (Ptr < End && FCharAnsi::IsDigit(*Ptr))
+			{
+				Index = FMath::Min(Index * 10 + (*Ptr++ - '0'), MaxPropertyIndex + 1);
+			}
+
+			if (Index > MaxPropertyIndex || Ptr == End || *Ptr++ != ']')
+			{
+				return false;
+			}
+			SkipBlanks();
+		}
+
+		if (Ptr == End || *Ptr++ != '=')
+		{
+			return false;
+		}
+		SkipBlanks();
+
+		auto& Property = Parent.Children.AddDefaulted_GetRef();
+		Property.Name = MakeString(NameStart, NameEnd);
+
+		// Name[N] inside an array of the same name is an element, anywhere else it declares an array of N elements
+		const auto bElement = Index != INDEX_NONE && Parent.IsArray() && Parent.Name == Property.Name;
+		const auto bArray = Index != INDEX_NONE && !bElement;
+		Property.Index = bElement ? Index : INDEX_NONE;
+
+		// Braces of multi line structs and arrays start on the next line
+		auto BraceSearch = Ptr;
+		while (!bInline && BraceSearch < End && (IsBlank(*BraceSearch) || *BraceSearch == '\n'))
+		{
+			BraceSearch++;
+		}
+
+		if (BraceSearch < End && *BraceSearch == '{')
+		{
+			// Past the limit the rest of the text can't be matched up with its braces, so parsing stops there
+			if (Depth >= MaxPropertyDepth)
+			{
+				Ptr = End;
+				return false;
+			}
+
+			Ptr = BraceSearch + 1;
+			Property.Type = bArray ? FActorXProperty::EType::Array : FActorXProperty::EType::Struct;
+			if (bArray)
+			{
+				Property.Children.Reserve(static_cast<int32>(FMath::Min<int64>(Index, (End - Ptr) / MinElementBytes)));
+			}
+
+			Depth++;
+			const auto bParsed = ParseBody(Property, true);
+			Depth--;
+			return bParsed;
+		}
+
+		Property.Value = ParseValue(bInline);
+		return true;
+	}
+
+	/** Values run until the end of the line, in single line structs they also end at a comma or the closing brace */
+	FString ParseValue(bool bInline)
+	{
+		const auto Start = Ptr;
+		ANSICHAR Quote = 0;
+		while (Ptr < End && *Ptr != '\n')
+		{
+			const auto Char = *Ptr;
+			if (Quote)
+			{
+				Quote = Char == Quote ? 0 : Quote;
+			}
+			else if (Char == '"' || Char == '\'')
+			{
+				Quote = Char;
+			}
+			else if (bInline && (Char == ',' || Char == '}'))
+			{
+				break;
+			}
+			Ptr++;
+		}
+
+		auto Stop = Ptr;
+		while (Stop > Start && IsBlank(Stop[-1]))
+		{
+			Stop--;
+		}
+
+		return MakeString(Start, Stop);
+	}
+
+	const ANSICHAR* Ptr;
+	const ANSICHAR* End;
+	int32 Depth = 0;
+	bool bValid = true;
+};
+
+const FActorXProperty* FActorXProperty::Find(FStringView ChildName) const
+{
+	return Children.FindByPredicate([ChildName](const FActorXProperty& Child)
+	{
+		return ChildName.Equals(Child.Name, ESearchCase::IgnoreCase);
+	});
+}
+
+bool FActorXProperty::TryGet(FStringView ChildName, FString& Out) const
+{
+	const auto Child = Find(ChildName);
+	if (!Child || Child->Type != EType::Value)
+	{
+		return false;
+	}
+
+	Out = Child->Value;
+	return true;
+}
+
+bool FActorXProperty::TryGet(FStringView ChildName, bool& Out) const
+{
+	const auto Child = Find(ChildName);
+	if (!Child || Child->Type != EType::Value)
+	{
+		return false;
+	}
+
+	Out = Child->Value.ToBool();
+	return true;
+}
+
+bool FActorXProperty::TryGet(FStringView ChildName, int64& Out) const
+{
+	const auto Child = Find(ChildName);
+	if (!Child || Child->Type != EType::Value || !Child->Value.IsNumeric())
+	{
+		return false;
+	}
+
+	Out = FCString::Atoi64(*Child->Value);
+	return true;
+}
+
+bool FActorXProperty::TryGet(FStringView ChildName, double& Out) const
+{
+	const auto Child = Find(ChildName);
+	if (!Child || Child->Type != EType::Value || Child->Value.IsEmpty())
+	{
+		return false;
+	}
+
+	Out = FCString::Atod(*Child->Value);
+	return true;
+}
+
+bool FActorXProperty::TryGet(FStringView ChildName, FVector& Out) const
+{
+	const auto Child = Find(ChildName);
+	if (!Child || !Child->IsStruct())
+	{
+		return false;
+	}
+
+	FVector Vector;
+	if (!Child->TryGet(TEXT("X"), Vector.X) || !Child->TryGet(TEXT("Y"), Vector.Y) || !Child->TryGet(TEXT("Z"), Vector.Z))
+	{
+		return false;
+	}
+
+	Out = Vector;
+	return true;
+}
+
+bool FActorXProperty::TryGet(FStringView ChildName, FRotator& Out) const
+{
+	const auto Child = Find(ChildName);
+	if (!Child || !Child->IsStruct())
+	{
+		return false;
+	}
+
+	FRotator Rotator;
+	if (!Child->TryGet(TEXT("Pitch"), Rotator.Pitch) || !Child->TryGet(TEXT("Yaw"), Rotator.Yaw) || !Child->TryGet(TEXT("Roll"), Rotator.Roll))
+	{
+		return false;
+	}
+
+	Out = Rotator;
+	return true;
+}
+
+bool FActorXProperties::Load(const FString& Filename)
+{
+	ACTORX_TRACE_SCOPE("ActorX.ReadProperties");
+
+	TArray64<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Filename, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	if (!Parse(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num()))
+	{
+		UE_LOG(LogActorXReader, Warning, TEXT("%s has lines that couldn't be parsed, they are ignored"), *Filename);
+	}
+
+	return true;
+}
+
+bool FActorXProperties::Parse(const ANSICHAR* Text, int64 Length)
+{
+	Root.Children.Reset();
+	return FActorXPropertyParser(Text, Length).ParseDocument(Root);
+}
@@ -0,0 +1,32 @@
+#include "Readers/ActorXTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(ActorXChannel);
+
+// Sequence keys are decoded from several threads at once
+TRACE_DECLARE_ATOMIC_MEMORY_COUNTER(ActorXBytesDecoded, TEXT("ActorX/BytesDecoded"));
+TRACE_DECLARE_ATOMIC_INT_COUNTER(ActorXRecordsDecoded, TEXT("ActorX/RecordsDecoded"));
+TRACE_DECLARE_ATOMIC_INT_COUNTER(ActorXChunksDecoded, TEXT("ActorX/ChunksDecoded"));
+
+FActorXChunkTimer::FActorXChunkTimer(const FActorXChunkView& InChunk, TArray<FActorXChunkStats>& InStats)
+	: Chunk(InChunk), Stats(InStats), StartCycles(FPlatformTime::Cycles64())
+{
+}
+
+FActorXChunkTimer::~FActorXChunkTimer()
+{
+	auto& ChunkStats = Stats.AddDefaulted_GetRef();
+	ChunkStats.ChunkID = ANSI_TO_TCHAR(Chunk.ChunkID);
+	ChunkStats.Bytes = Chunk.GetDataBytes();
+	ChunkStats.Elements = Chunk.DataCount;
+	ChunkStats.Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	TRACE_COUNTER_INCREMENT(ActorXChunksDecoded);
+	ActorXTraceDecoded(ChunkStats.Bytes, ChunkStats.Elements);
+}
+
+void ActorXTraceDecoded(int64 Bytes, int64 Records)
+{
+	TRACE_COUNTER_ADD(ActorXBytesDecoded, Bytes);
+	TRACE_COUNTER_ADD(ActorXRecordsDecoded, Records);
+}
@@ -0,0 +1,231 @@
+#include "Readers/PSAReader.h"
+#include "UnrealPSKPSAReaders.h"
+#include "Readers/ActorXTrace.h"
+#include "Utils/ActorXConversion.h"
+
+using FAnimKeyDecoder = TActorXRecordDecoder<VQuatAnimKey>;
+
+static constexpr TActorXChunkDecoder<PSAReader> PSAChunkDecoders[] =
+{
+	{ ActorXChunkId("ANIMINFO"), &DecodeChunkInto<PSAReader, VAnimInfoBinary, &PSAReader::AnimInfo> },
+	{ ActorXChunkId("BONENAMES"), &DecodeChunkInto<PSAReader, VNamedBoneBinary, &PSAReader::Bones> },
+	{ ActorXChunkId("ANIMKEYS"), &DecodeChunkInto<PSAReader, VQuatAnimKey, &PSAReader::AnimKeys> },
+	{ ActorXChunkId("SCALEKEYS"), &DecodeChunkInto<PSAReader, VAnimScaleKey, &PSAReader::ScaleKeys> },
+};
+
+static TActorXChunkRegistry<PSAReader> PSAChunkRegistry;
+
+void PSAReader::RegisterChunkDecoder(uint64 ChunkId, TActorXChunkDecoder<PSAReader>::FDecodeFunc Decode)
+{
+	PSAChunkRegistry.Register(ChunkId, Decode);
+}
+
+void PSAReader::UnregisterChunkDecoder(uint64 ChunkId)
+{
+	PSAChunkRegistry.Unregister(ChunkId);
+}
+
+PSAReader::PSAReader(const FString Filename, bool bLoadPropertiesFile /*= false*/)
+{
+	FileName = Filename;
+	bLoadProperties = bLoadPropertiesFile;
+}
+
+bool PSAReader::Read()
+{
+	ACTORX_TRACE_SCOPE("ActorX.ReadPSA");
+
+	if (!Open())
+		return false;
+
+	auto bSuccess = true;
+	const auto& Chunks = Directory.GetChunks();
+	for (auto i = 0; i < Chunks.Num(); i++)
+	{
+		if (Directory.MarkDecoded(i))
+		{
+			bSuccess &= DecodeChunk(Chunks[i]);
+		}
+	}
+
+	return bSuccess;
+}
+
+bool PSAReader::Open()
+{
+	if (Directory.IsOpen())
+		return true;
+
+	if (bLoadProperties && Properties.IsEmpty() && !ReadPropertiesFile())
+		return false;
+
+	return Directory.Open(FileName, ActorXChunkId("ANIMHEAD"));
+}
+
+void PSAReader::Close()
+{
+	Directory.Close();
+	CacheEntry.Close();
+}
+
+bool PSAReader::ReadChunk(uint64 ChunkId)
+{
+	if (!Directory.IsOpen())
+		return false;
+
+	auto bSuccess = true;
+	const auto& Chunks = Directory.GetChunks();
+	for (auto i = 0; i < Chunks.Num(); i++)
+	{
+		if (Chunks[i].Is(ChunkId) && Directory.MarkDecoded(i))
+		{
+			bSuccess &= DecodeChunk(Chunks[i]);
+		}
+	}
+
+	return bSuccess;
+}
+
+int32 PSAReader::GetNumBones() const
+{
+	const auto BoneChunk = Directory.Find(ActorXChunkId("BONENAMES"));
+	return BoneChunk ? BoneChunk->DataCount : Bones.Num();
+}
+
+bool PSAReader::ReadSequenceTracks(const VAnimInfoBinary& Info, TArray<FPSABoneTrack>& OutTracks) const
+{
+	ACTORX_TRACE_SCOPE("ActorX.ReadSequenceTracks");
+
+	const auto NumBones = GetNumBones();
+	OutTracks.Reset();
+	OutTracks.SetNum(NumBones);
+
+	const auto KeyChunk = Directory.Find(ActorXChunkId("ANIMKEYS"));
+	if (!KeyChunk || KeyChunk->DataSize < FAnimKeyDecoder::RecordSize || NumBones == 0)
+		return false;
+
+	const auto FirstKey = FMath::Clamp<int64>(Info.FirstRawFrame * static_cast<int64>(NumBones), 0, KeyChunk->DataCount);
+	const auto NumFrames = FMath::Clamp<int64>(Info.NumRawFrames, 0, (KeyChunk->DataCount - FirstKey) / NumBones);
+
+	const auto ScaleChunk = Directory.Find(ActorXChunkId("SCALEKEYS"));
+	const auto bHasSequenceScaleKeys = ScaleChunk && ScaleChunk->DataSize >= static_cast<int32>(sizeof(VAnimScaleKey)) && ScaleChunk->DataCount >= FirstKey + NumFrames * NumBones;
+
+	for (auto& Track : OutTracks)
+	{
+		Track.PositionalKeys.SetNumUninitialized(NumFrames);
+		Track.RotationalKeys.SetNumUninitialized(NumFrames);
+		Track.ScaleKeys.SetNumUninitialized(NumFrames);
+	}
+
+	// Walk the file window in order and scatter each frame across the bone tracks
+	for (auto Frame = 0; Frame < NumFrames; Frame++)
+	{
+		const auto FrameKey = FirstKey + Frame * NumBones;
+		for (auto BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			auto& Track = OutTracks[BoneIndex];
+
+			VQuatAnimKey Key;
+			FAnimKeyDecoder::DecodeRecord(KeyChunk->GetRecord(FrameKey + BoneIndex), Key);
+			Track.PositionalKeys[Frame] = Key.Position;
+			Track.RotationalKeys[Frame] = Key.Orientation;
+
+			if (bHasSequenceScaleKeys)
+			{
+				FActorXRecordCursor ScaleCursor(ScaleChunk->GetRecord(FrameKey + BoneIndex));
+				ScaleCursor.Read(Track.ScaleKeys[Frame]);
+			}
+			else
+			{
+				Track.ScaleKeys[Frame] = FVector3f::OneVector;
+			}
+		}
+	}
+
+	const auto NumKeys = NumFrames * NumBones;
+	ActorXTraceDecoded(NumKeys * (KeyChunk->DataSize + (bHasSequenceScaleKeys ? ScaleChunk->DataSize : 0)), NumKeys * (bHasSequenceScaleKeys ? 2 : 1));
+	return true;
+}
+
+bool PSAReader::OpenConverted()
+{
+	// Properties aren't cached
+	if (bLoadProperties && Properties.IsEmpty() && !ReadPropertiesFile())
+		return false;
+
+	const auto CacheKey = FActorXParseCache::IsEnabled() ? FActorXParseCache::MakeKey(FileName) : FString();
+	if (!CacheKey.IsEmpty() && CacheEntry.Open(CacheKey, AnimInfo, Bones))
+	{
+		bFromCache = true;
+		return true;
+	}
+
+	if (!Open() || !ReadChunk(ActorXChunkId("ANIMINFO")) || !ReadChunk(ActorXChunkId("BONENAMES")))
+		return false;
+
+	// Without an entry the tracks are decoded and converted straight from the file
+	if (!CacheKey.IsEmpty() && FActorXParseCache::SaveAnim(CacheKey, *this))
+	{
+		TArray<VAnimInfoBinary> CachedAnimInfo;
+		TArray<VNamedBoneBinary> CachedBones;
+		CacheEntry.Open(CacheKey, CachedAnimInfo, CachedBones);
+	}
+
+	return true;
+}
+
+bool PSAReader::ReadConvertedTracks(int32 SequenceIndex, TArray<FPSABoneTrack>& OutTracks) const
+{
+	if (CacheEntry.IsOpen())
+		return CacheEntry.ReadTracks(SequenceIndex, OutTracks);
+
+	if (!AnimInfo.IsValidIndex(SequenceIndex) || !ReadSequenceTracks(AnimInfo[SequenceIndex], OutTracks))
+		return false;
+
+	ConvertTracks(OutTracks);
+	return true;
+}
+
+void PSAReader::ConvertTracks(TArrayView<FPSABoneTrack> Tracks)
+{
+	for (auto BoneIndex = 0; BoneIndex < Tracks.Num(); BoneIndex++)
+	{
+		FActorXConversion::MirrorVectors(Tracks[BoneIndex].PositionalKeys);
+		FActorXConversion::ConvertRotations(Tracks[BoneIndex].RotationalKeys, BoneIndex == 0);
+	}
+}
+
+bool PSAReader::DecodeChunk(const FActorXChunkView& Chunk)
+{
+	// Chunks nobody knows about are skipped
+	const auto Decode = PSAChunkRegistry.Find(Chunk.Id, MakeArrayView(PSAChunkDecoders));
+	if (!Decode)
+		return true;
+
+	ACTORX_TRACE_SCOPE("ActorX.DecodeChunk");
+	FActorXChunkTimer Timer(Chunk, ChunkStats);
+
+	const auto bValid = Decode(*this, Chunk);
+	if (!bValid)
+	{
+		UE_LOG(LogActorXReader, Error, TEXT("%s has invalid data in chunk %hs"), *FileName, Chunk.ChunkID);
+	}
+
+	bHasScaleKeys = ScaleKeys.Num() > 0;
+	return bValid;
+}
+
+bool PSAReader::ReadPropertiesFile()
+{
+	const auto PropsFile = FPaths::ChangeExtension(FileName, "props.txt");
+
+	UE_LOG(LogActorXReader, Log, TEXT("Loading properties: %s"), *PropsFile);
+
+	if (!Properties.Load(PropsFile))
+	{
+		UE_LOG(LogActorXReader, Error, TEXT("Failed to open properties file at: %s"), *PropsFile);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,301 @@
+#include "Readers/PSKReader.h"
+#include "Algo/StableSort.h"
+#include "Containers/StaticArray.h"
+#include "UnrealPSKPSAReaders.h"
+#include "Readers/ActorXIndexDecoder.h"
+#include "Readers/ActorXTrace.h"
+#include "Utils/ActorXConversion.h"
+
+// Indices are checked against the counts in the directory so chunks can be decoded in any order
+static int32 GetChunkCount(const PSKReader& Reader, uint64 ChunkId, int32 DecodedCount)
+{
+	const auto Found = Reader.GetDirectory().Find(ChunkId);
+	return Found ? Found->DataCount : DecodedCount;
+}
+
+static bool DecodeWedges(PSKReader& Reader, const FActorXChunkView& Chunk)
+{
+	return FActorXIndexDecoder::DecodeWedges(Chunk, GetChunkCount(Reader, ActorXChunkId("PNTS0000"), Reader.Vertices.Num()), Reader.Wedges);
+}
+
+static bool DecodeFaces16(PSKReader& Reader, const FActorXChunkView& Chunk)
+{
+	return FActorXIndexDecoder::DecodeFaces16(Chunk, GetChunkCount(Reader, ActorXChunkId("VTXW0000"), Reader.Wedges.Num()), Reader.Faces);
+}
+
+static bool DecodeFaces32(PSKReader& Reader, const FActorXChunkView& Chunk)
+{
+	return FActorXIndexDecoder::DecodeFaces32(Chunk, GetChunkCount(Reader, ActorXChunkId("VTXW0000"), Reader.Wedges.Num()), Reader.Faces);
+}
+
+static bool DecodeExtraUVs(PSKReader& Reader, const FActorXChunkView& Chunk)
+{
+	// There's one chunk per extra UV set, a set that fails to decode isn't added
+	TArray<FVector2f> UVs;
+	if (!Chunk.CopyTo(UVs))
+	{
+		return false;
+	}
+
+	Reader.ExtraUVs.Add(MoveTemp(UVs));
+	return true;
+}
+
+static constexpr TActorXChunkDecoder<PSKReader> PSKChunkDecoders[] =
+{
+	{ ActorXChunkId("PNTS0000"), &DecodeChunkInto<PSKReader, FVector3f, &PSKReader::Vertices> },
+	{ ActorXChunkId("VTXW0000"), &DecodeWedges },
+	{ ActorXChunkId("FACE0000"), &DecodeFaces16 },
+	{ ActorXChunkId("FACE3200"), &DecodeFaces32 },
+	{ ActorXChunkId("MATT0000"), &DecodeChunkInto<PSKReader, VMaterial, &PSKReader::Materials> },
+	{ ActorXChunkId("VTXNORMS"), &DecodeChunkInto<PSKReader, FVector3f, &PSKReader::Normals> },
+	{ ActorXChunkId("VERTEXCOLOR"), &DecodeChunkInto<PSKReader, FColor, &PSKReader::VertexColors> },
+	{ ActorXChunkId("EXTRAUVS"), &DecodeExtraUVs },
+	{ ActorXChunkId("REFSKELT"), &DecodeChunkInto<PSKReader, VNamedBoneBinary, &PSKReader::Bones> },
+	{ ActorXChunkId("REFSKEL0"), &DecodeChunkInto<PSKReader, VNamedBoneBinary, &PSKReader::Bones> },
+	{ ActorXChunkId("RAWWEIGHTS"), &DecodeChunkInto<PSKReader, VRawBoneInfluence, &PSKReader::Influences> },
+	{ ActorXChunkId("RAWW0000"), &DecodeChunkInto<PSKReader, VRawBoneInfluence, &PSKReader::Influences> },
+};
+
+static TActorXChunkRegistry<PSKReader> PSKChunkRegistry;
+
+void PSKReader::RegisterChunkDecoder(uint64 ChunkId, TActorXChunkDecoder<PSKReader>::FDecodeFunc Decode)
+{
+	PSKChunkRegistry.Register(ChunkId, Decode);
+}
+
+void PSKReader::UnregisterChunkDecoder(uint64 ChunkId)
+{
+	PSKChunkRegistry.Unregister(ChunkId);
+}
+
+PSKReader::PSKReader(const FString Filename, bool bLoadPropertiesFile /*= false*/)
+{
+	FileName = Filename;
+	bLoadProperties = bLoadPropertiesFile;
+}
+
+bool PSKReader::Read()
+{
+	ACTORX_TRACE_SCOPE("ActorX.ReadPSK");
+
+	// Load properties first if we want them
+	if (bLoadProperties)
+	{
+		if (!ReadPropertiesFile())
+		{
+			return false;
+		}
+	}
+
+	if (!Open())
+		return false;
+
+	auto bSuccess = true;
+	const auto& Chunks = Directory.GetChunks();
+	for (auto i = 0; i < Chunks.Num(); i++)
+	{
+		if (Directory.MarkDecoded(i))
+		{
+			bSuccess &= DecodeChunk(Chunks[i]);
+		}
+	}
+
+	UpdateSwitches();
+	Close();
+	return bSuccess;
+}
+
+bool PSKReader::ReadConverted()
+{
+	const auto CacheKey = FActorXParseCache::IsEnabled() ? FActorXParseCache::MakeKey(FileName) : FString();
+	if (!CacheKey.IsEmpty() && FActorXParseCache::LoadMesh(CacheKey, *this))
+	{
+		// Properties aren't cached
+		if (bLoadProperties && !ReadPropertiesFile())
+			return false;
+
+		bConverted = true;
+		bFromCache = true;
+		UpdateSwitches();
+		return true;
+	}
+
+	if (!Read())
+		return false;
+
+	Convert();
+
+	if (!CacheKey.IsEmpty())
+	{
+		FActorXParseCache::SaveMesh(CacheKey, *this);
+	}
+
+	return true;
+}
+
+void PSKReader::Convert()
+{
+	if (bConverted)
+		return;
+
+	ACTORX_TRACE_SCOPE("ActorX.ConvertPSK");
+
+	// MIRROR_MESH
+	FActorXConversion::MirrorVectors(Normals);
+	Bounds = FActorXConversion::MirrorPoints(Vertices);
+
+	// Mirroring flips the handedness, so the faces are wound the other way to keep facing outwards
+	for (auto& Face : Faces)
+	{
+		Swap(Face.WedgeIndex[0], Face.WedgeIndex[2]);
+	}
+
+	for (auto& Color : VertexColors)
+	{
+		Swap(Color.R, Color.B);
+	}
+
+	bConverted = true;
+}
+
+int32 PSKReader::MergeMaterials()
+{
+	ACTORX_TRACE_SCOPE("ActorX.MergeMaterials");
+
+	// Material names are looked up as asset names, which don't care about case
+	TMap<FString, int32> MergedByName;
+	TArray<VMaterial> MergedMaterials;
+	TArray<int32> Remap;
+	Remap.SetNumUninitialized(Materials.Num());
+	for (auto i = 0; i < Materials.Num(); i++)
+	{
+		const FString Name(Materials[i].MaterialName);
+		Remap[i] = MergedByName.FindOrAdd(Name.ToLower(), MergedMaterials.Num());
+		if (Remap[i] == MergedMaterials.Num())
+		{
+			MergedMaterials.Add(Materials[i]);
+		}
+	}
+
+	const auto NumRemoved = Materials.Num() - MergedMaterials.Num();
+	if (NumRemoved == 0)
+	{
+		return 0;
+	}
+
+	// Every index a byte can hold gets its new index up front. Indices past the material list have no slot to merge into,
+	// they follow the last merged slot in order so they stay past the end and keep their distance to each other
+	TStaticArray<uint8, 256> NewIndex;
+	for (auto Index = 0; Index < 256; Index++)
+	{
+		NewIndex[Index] = static_cast<uint8>(Index < Remap.Num() ? Remap[Index] : MergedMaterials.Num() + Index - Remap.Num());
+	}
+
+	for (auto& Wedge : Wedges)
+	{
+		Wedge.MatIndex = static_cast<char>(NewIndex[static_cast<uint8>(Wedge.MatIndex)]);
+	}
+
+	for (auto& Face : Faces)
+	{
+		Face.MatIndex = static_cast<char>(NewIndex[static_cast<uint8>(Face.MatIndex)]);
+	}
+
+	Algo::StableSortBy(Faces, [](const VTriangle& Face) { return static_cast<uint8>(Face.MatIndex); });
+
+	Materials = MoveTemp(MergedMaterials);
+	return NumRemoved;
+}
+
+bool PSKReader::Open()
+{
+	return Directory.IsOpen() || Directory.Open(FileName, ActorXChunkId("ACTRHEAD"));
+}
+
+void PSKReader::Close()
+{
+	Directory.Close();
+}
+
+bool PSKReader::ReadChunk(uint64 ChunkId)
+{
+	if (!Directory.IsOpen())
+		return false;
+
+	auto bSuccess = true;
+	const auto& Chunks = Directory.GetChunks();
+	for (auto i = 0; i < Chunks.Num(); i++)
+	{
+		if (Chunks[i].Is(ChunkId) && Directory.MarkDecoded(i))
+		{
+			bSuccess &= DecodeChunk(Chunks[i]);
+		}
+	}
+
+	UpdateSwitches();
+	return bSuccess;
+}
+
+bool PSKReader::DecodeChunk(const FActorXChunkView& Chunk)
+{
+	// Chunks nobody knows about are skipped
+	const auto Decode = PSKChunkRegistry.Find(Chunk.Id, MakeArrayView(PSKChunkDecoders));
+	if (!Decode)
+		return true;
+
+	ACTORX_TRACE_SCOPE("ActorX.DecodeChunk");
+	FActorXChunkTimer Timer(Chunk, ChunkStats);
+
+	if (!Decode(*this, Chunk))
+	{
+		UE_LOG(LogActorXReader, Error, TEXT("%s has invalid data in chunk %hs"), *FileName, Chunk.ChunkID);
+		return false;
+	}
+
+	return true;
+}
+
+void PSKReader::UpdateSwitches()
+{
+	bHasVertexNormals = Normals.Num() > 0;
+	bHasVertexColors = VertexColors.Num() > 0;
+	bHasExtraUVs = ExtraUVs.Num() > 0;
+}
+
+bool PSKReader::ReadPropertiesFile()
+{
+	const auto PropsFile = FPaths::ChangeExtension(FileName, "props.txt");
+
+	UE_LOG(LogActorXReader, Log, TEXT("Loading properties: %s"), *PropsFile);
+
+	// The parse cache path reads the properties again after a previous read, they replace what was there
+	Sockets.Reset();
+	if (!Properties.Load(PropsFile))
+	{
+		UE_LOG(LogActorXReader, Error, TEXT("Failed to open properties file at: %s"), *PropsFile);
+		return false;
+	}
+
+	// Static meshes don't have sockets, so the array is optional
+	const auto SocketArray = Properties.Find(TEXT("Sockets"));
+	if (!SocketArray)
+		return true;
+
+	Sockets.Reserve(SocketArray->Children.Num());
+	for (const auto& Element : SocketArray->Children)
+	{
+		auto& NewSocket = Sockets.AddDefaulted_GetRef();
+		NewSocket.RelativeLocation = FVector::ZeroVector;
+		NewSocket.RelativeRotation = FRotator::ZeroRotator;
+		NewSocket.RelativeScale = FVector::OneVector;
+
+		Element.TryGet(TEXT("SocketName"), NewSocket.SocketName);
+		Element.TryGet(TEXT("BoneName"), NewSocket.BoneName);
+		Element.TryGet(TEXT("RelativeLocation"), NewSocket.RelativeLocation);
+		Element.TryGet(TEXT("RelativeRotation"), NewSocket.RelativeRotation);
+		Element.TryGet(TEXT("RelativeScale"), NewSocket.RelativeScale);
+	}
+
+	return true;
+}
@@ -0,0 +1,65 @@
+#include "Utils/ActorXConversion.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Counts around the four-wide packing, so the scalar tails of the vectorised loops are covered too
+static constexpr int32 ConversionTestCounts[] = { 0, 1, 2, 3, 4, 5, 7, 8, 13, 1021 };
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorXConversionTest, "Plugins.UnrealPSKPSA.Conversion.VectorisedMatchesScalar",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FActorXConversionTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Random(0x41435458);
+	for (const auto Count : ConversionTestCounts)
+	{
+		TArray<FVector3f> Points;
+		TArray<FQuat4f> Rotations;
+		for (auto i = 0; i < Count; i++)
+		{
+			Points.Emplace(Random.FRandRange(-1000.f, 1000.f), Random.FRandRange(-1000.f, 1000.f), Random.FRandRange(-1000.f, 1000.f));
+			Rotations.Emplace(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f));
+		}
+
+		// Mirroring only flips signs, so both paths have to agree to the bit
+		auto VectorPoints = Points;
+		auto ScalarPoints = Points;
+		const auto VectorBounds = FActorXConversion::MirrorPoints(VectorPoints);
+		const auto ScalarBounds = FActorXConversion::MirrorPointsScalar(ScalarPoints);
+		TestTrue(FString::Printf(TEXT("Mirrored points match for %d points"), Count), FMemory::Memcmp(VectorPoints.GetData(), ScalarPoints.GetData(), Count * sizeof(FVector3f)) == 0);
+		TestEqual(FString::Printf(TEXT("Bounds validity matches for %d points"), Count), VectorBounds.IsValid, ScalarBounds.IsValid);
+		if (Count > 0)
+		{
+			TestTrue(FString::Printf(TEXT("Bounds match for %d points"), Count), VectorBounds.Min == ScalarBounds.Min && VectorBounds.Max == ScalarBounds.Max);
+		}
+
+		auto VectorNormals = Points;
+		auto ScalarNormals = Points;
+		FActorXConversion::MirrorVectors(VectorNormals);
+		FActorXConversion::MirrorVectorsScalar(ScalarNormals);
+		TestTrue(FString::Printf(TEXT("Mirrored vectors match for %d vectors"), Count), FMemory::Memcmp(VectorNormals.GetData(), ScalarNormals.GetData(), Count * sizeof(FVector3f)) == 0);
+
+		// Normalising goes through a different square root on each path, so rotations only agree to rounding
+		for (const auto bRootBone : { false, true })
+		{
+			auto VectorRotations = Rotations;
+			auto ScalarRotations = Rotations;
+			FActorXConversion::ConvertRotations(VectorRotations, bRootBone);
+			FActorXConversion::ConvertRotationsScalar(ScalarRotations, bRootBone);
+			for (auto i = 0; i < Count; i++)
+			{
+				if (!VectorRotations[i].Equals(ScalarRotations[i], 1e-6f))
+				{
+					AddError(FString::Printf(TEXT("Rotation %d of %d differs (root %d): %s vs %s"), i, Count, bRootBone, *VectorRotations[i].ToString(), *ScalarRotations[i].ToString()));
+					break;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,8 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealPSKPSAReaders.h"
+#include "Modules/ModuleManager.h"
+
+DEFINE_LOG_CATEGORY(LogActorXReader);
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, UnrealPSKPSAReaders)
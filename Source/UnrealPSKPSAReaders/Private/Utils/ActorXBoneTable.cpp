@@ -0,0 +1,51 @@
+#include "Utils/ActorXBoneTable.h"
+#include "UnrealPSKPSAReaders.h"
+#include "Readers/ActorXTrace.h"
+
+void FActorXBoneTable::Build(TConstArrayView<VNamedBoneBinary> FileBones)
+{
+	ACTORX_TRACE_SCOPE("ActorX.BuildBoneTable");
+
+	Bones.Reset(FileBones.Num());
+	FileToTable.SetNumUninitialized(FileBones.Num());
+	IndexByName.Reset();
+	IndexByName.Reserve(FileBones.Num());
+	MaxDepth = 0;
+	NumDuplicates = 0;
+	NumReparented = 0;
+
+	for (auto FileIndex = 0; FileIndex < FileBones.Num(); FileIndex++)
+	{
+		const auto& FileBone = FileBones[FileIndex];
+		const FName Name(FileBone.Name);
+
+		const auto TableIndex = IndexByName.FindOrAdd(Name, Bones.Num());
+		FileToTable[FileIndex] = TableIndex;
+		if (TableIndex != Bones.Num())
+		{
+			NumDuplicates++;
+			continue;
+		}
+
+		auto& Bone = Bones.AddDefaulted_GetRef();
+		Bone.Name = Name;
+		Bone.FileIndex = FileIndex;
+
+		// The first bone is the root whatever its parent says, the others need a parent that is already in the table
+		if (FileIndex > 0)
+		{
+			const auto ParentIndex = FileBones.IsValidIndex(FileBone.ParentIndex) && FileBone.ParentIndex < FileIndex ? FileToTable[FileBone.ParentIndex] : INDEX_NONE;
+			if (ParentIndex == INDEX_NONE)
+			{
+				UE_LOG(LogActorXReader, Warning, TEXT("Bone %s has an invalid parent %d, attaching it to the root"), *Name.ToString(), FileBone.ParentIndex);
+				NumReparented++;
+			}
+
+			Bone.ParentIndex = ParentIndex == INDEX_NONE ? 0 : ParentIndex;
+			Bone.Depth = Bones[Bone.ParentIndex].Depth + 1;
+			Bones[Bone.ParentIndex].NumChildren++;
+		}
+
+		MaxDepth = FMath::Max(MaxDepth, Bone.Depth);
+	}
+}
@@ -0,0 +1,109 @@
+#include "Utils/ActorXConversion.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarActorXScalarConversion(
+	TEXT("ActorX.ScalarConversion"),
+	false,
+	TEXT("Use the scalar reference path instead of the vectorised one when converting ActorX data."));
+
+FBox3f FActorXConversion::MirrorPoints(TArrayView<FVector3f> Points)
+{
+	if (CVarActorXScalarConversion.GetValueOnAnyThread())
+	{
+		return MirrorPointsScalar(Points);
+	}
+
+	if (Points.IsEmpty())
+	{
+		return FBox3f(ForceInit);
+	}
+
+	const auto Mirror = MakeVectorRegisterFloat(1.f, -1.f, 1.f, 0.f);
+	auto Min = VectorSetFloat1(UE_MAX_FLT);
+	auto Max = VectorSetFloat1(-UE_MAX_FLT);
+
+	// Mirror and accumulate the bounds in the same pass over the points
+	for (auto& Point : Points)
+	{
+		const auto Mirrored = VectorMultiply(VectorLoadFloat3(&Point.X), Mirror);
+		VectorStoreFloat3(Mirrored, &Point.X);
+
+		Min = VectorMin(Min, Mirrored);
+		Max = VectorMax(Max, Mirrored);
+	}
+
+	FBox3f Bounds(ForceInit);
+	VectorStoreFloat3(Min, &Bounds.Min.X);
+	VectorStoreFloat3(Max, &Bounds.Max.X);
+	Bounds.IsValid = 1;
+	return Bounds;
+}
+
+void FActorXConversion::MirrorVectors(TArrayView<FVector3f> Vectors)
+{
+	if (CVarActorXScalarConversion.GetValueOnAnyThread())
+	{
+		MirrorVectorsScalar(Vectors);
+		return;
+	}
+
+	// Four packed vectors fill exactly three registers, so the Y lanes fall in a fixed pattern
+	const auto Mirror0 = MakeVectorRegisterFloat(1.f, -1.f, 1.f, 1.f);
+	const auto Mirror1 = MakeVectorRegisterFloat(-1.f, 1.f, 1.f, -1.f);
+	const auto Mirror2 = MakeVectorRegisterFloat(1.f, 1.f, -1.f, 1.f);
+
+	const auto NumPacked = Vectors.Num() & ~3;
+	auto Data = reinterpret_cast<float*>(Vectors.GetData());
+	for (auto i = 0; i < NumPacked; i += 4, Data += 12)
+	{
+		VectorStore(VectorMultiply(VectorLoad(Data), Mirror0), Data);
+		VectorStore(VectorMultiply(VectorLoad(Data + 4), Mirror1), Data + 4);
+		VectorStore(VectorMultiply(VectorLoad(Data + 8), Mirror2), Data + 8);
+	}
+
+	MirrorVectorsScalar(Vectors.RightChop(NumPacked));
+}
+
+void FActorXConversion::ConvertRotations(TArrayView<FQuat4f> Rotations, bool bRootBone)
+{
+	if (CVarActorXScalarConversion.GetValueOnAnyThread())
+	{
+		ConvertRotationsScalar(Rotations, bRootBone);
+		return;
+	}
+
+	const auto Flip = MakeVectorRegisterFloat(-1.f, 1.f, -1.f, bRootBone ? 1.f : -1.f);
+	for (auto& Rotation : Rotations)
+	{
+		const auto Flipped = VectorMultiply(VectorLoad(&Rotation.X), Flip);
+		VectorStore(VectorNormalizeQuaternion(Flipped), &Rotation.X);
+	}
+}
+
+FBox3f FActorXConversion::MirrorPointsScalar(TArrayView<FVector3f> Points)
+{
+	FBox3f Bounds(ForceInit);
+	for (auto& Point : Points)
+	{
+		Point = MirrorVector(Point);
+		Bounds += Point;
+	}
+
+	return Bounds;
+}
+
+void FActorXConversion::MirrorVectorsScalar(TArrayView<FVector3f> Vectors)
+{
+	for (auto& Vector : Vectors)
+	{
+		Vector = MirrorVector(Vector);
+	}
+}
+
+void FActorXConversion::ConvertRotationsScalar(TArrayView<FQuat4f> Rotations, bool bRootBone)
+{
+	for (auto& Rotation : Rotations)
+	{
+		Rotation = ConvertRotation(Rotation, bRootBone);
+	}
+}
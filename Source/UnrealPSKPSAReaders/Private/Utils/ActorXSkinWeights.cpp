@@ -0,0 +1,120 @@
+#include "Utils/ActorXSkinWeights.h"
+#include "Readers/ActorXTrace.h"
+
+void FActorXSkinWeights::Build(TConstArrayView<VRawBoneInfluence> Influences, int32 PointCount, int32 MaxInfluences, float WeightThreshold, EParallelForFlags Flags)
+{
+	ACTORX_TRACE_SCOPE("ActorX.BuildSkinWeights");
+
+	MaxInfluences = FMath::Max(MaxInfluences, 1);
+
+	// Counting sort of the influences by point, stable so equal weights keep the file's order
+	TArray<int32> RawOffsets;
+	RawOffsets.SetNumZeroed(PointCount + 1);
+	for (const auto& Influence : Influences)
+	{
+		if (Influence.PointIdx >= 0 && Influence.PointIdx < PointCount)
+		{
+			RawOffsets[Influence.PointIdx + 1]++;
+		}
+	}
+
+	for (auto Point = 0; Point < PointCount; Point++)
+	{
+		RawOffsets[Point + 1] += RawOffsets[Point];
+	}
+
+	TArray<int32> RawBones;
+	TArray<float> RawWeights;
+	RawBones.SetNumUninitialized(RawOffsets[PointCount]);
+	RawWeights.SetNumUninitialized(RawOffsets[PointCount]);
+	{
+		auto Next = RawOffsets;
+		for (const auto& Influence : Influences)
+		{
+			if (Influence.PointIdx >= 0 && Influence.PointIdx < PointCount)
+			{
+				const auto Index = Next[Influence.PointIdx]++;
+				RawBones[Index] = Influence.BoneIdx;
+				RawWeights[Index] = Influence.Weight;
+			}
+		}
+	}
+
+	// Every point prunes its own row in place and records how many influences it kept
+	TArray<int32> KeptCounts;
+	KeptCounts.SetNumUninitialized(PointCount);
+	ParallelFor(PointCount, [&](int32 Point)
+	{
+		const auto Start = RawOffsets[Point];
+		auto Count = RawOffsets[Point + 1] - Start;
+		auto Bones = MakeArrayView(RawBones).Slice(Start, Count);
+		auto PointWeights = MakeArrayView(RawWeights).Slice(Start, Count);
+
+		// Influences on the same bone add up
+		for (auto i = 0; i < Count; i++)
+		{
+			for (auto j = i + 1; j < Count; j++)
+			{
+				if (Bones[j] == Bones[i])
+				{
+					PointWeights[i] += PointWeights[j];
+					Bones[j] = Bones[Count - 1];
+					PointWeights[j] = PointWeights[Count - 1];
+					Count--;
+					j--;
+				}
+			}
+		}
+
+		// Rows are short, an insertion sort by descending weight is all they need
+		for (auto i = 1; i < Count; i++)
+		{
+			for (auto j = i; j > 0 && (PointWeights[j] > PointWeights[j - 1] || (PointWeights[j] == PointWeights[j - 1] && Bones[j] < Bones[j - 1])); j--)
+			{
+				Swap(PointWeights[j], PointWeights[j - 1]);
+				Swap(Bones[j], Bones[j - 1]);
+			}
+		}
+
+		Count = FMath::Min(Count, MaxInfluences);
+		while (Count > 1 && PointWeights[Count - 1] < WeightThreshold)
+		{
+			Count--;
+		}
+
+		auto Total = 0.f;
+		for (auto i = 0; i < Count; i++)
+		{
+			Total += PointWeights[i];
+		}
+
+		// A row of zero weights can't be scaled, its bones share the point evenly instead
+		for (auto i = 0; i < Count; i++)
+		{
+			PointWeights[i] = Total > UE_SMALL_NUMBER ? PointWeights[i] / Total : 1.f / Count;
+		}
+
+		KeptCounts[Point] = Count;
+	}, Flags);
+
+	Offsets.SetNumUninitialized(PointCount + 1);
+	Offsets[0] = 0;
+	MaxPointInfluences = 0;
+	NumUnweightedPoints = 0;
+	for (auto Point = 0; Point < PointCount; Point++)
+	{
+		Offsets[Point + 1] = Offsets[Point] + KeptCounts[Point];
+		MaxPointInfluences = FMath::Max(MaxPointInfluences, KeptCounts[Point]);
+		NumUnweightedPoints += KeptCounts[Point] == 0 ? 1 : 0;
+	}
+
+	BoneIndices.SetNumUninitialized(Offsets[PointCount]);
+	Weights.SetNumUninitialized(Offsets[PointCount]);
+	ParallelFor(PointCount, [&](int32 Point)
+	{
+		FMemory::Memcpy(BoneIndices.GetData() + Offsets[Point], RawBones.GetData() + RawOffsets[Point], KeptCounts[Point] * sizeof(int32));
+		FMemory::Memcpy(Weights.GetData() + Offsets[Point], RawWeights.GetData() + RawOffsets[Point], KeptCounts[Point] * sizeof(float));
+	}, Flags);
+
+	NumPruned = Influences.Num() - BoneIndices.Num();
+}
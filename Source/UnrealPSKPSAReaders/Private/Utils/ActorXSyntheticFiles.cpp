@@ -0,0 +1,323 @@
+#include "Utils/ActorXSyntheticFiles.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Utils/ActorXModels.h"
+#include <type_traits>
+
+// Written by most exporters, the readers don't check it
+static constexpr int32 ChunkTypeFlag = 20100422;
+
+/** Appends little endian records to a file image one field at a time, so the on-disk layout never depends on struct padding */
+class FActorXFileWriter
+{
+public:
+	void BeginChunk(const char* ChunkName, int32 DataSize, int32 DataCount)
+	{
+		char ChunkID[20] {};
+		FCStringAnsi::Strncpy(ChunkID, ChunkName, sizeof(ChunkID));
+
+		Write(ChunkID, sizeof(ChunkID));
+		Write(ChunkTypeFlag);
+		Write(DataSize);
+		Write(DataCount);
+		Buffer.Reserve(Buffer.Num() + static_cast<int64>(DataSize) * DataCount);
+	}
+
+	void Write(const void* Data, int64 Size)
+	{
+		Buffer.Append(static_cast<const uint8*>(Data), Size);
+	}
+
+	template <typename T>
+	void Write(const T& Value)
+	{
+		static_assert(std::is_arithmetic_v<T>, "Write structs field by field");
+		Write(&Value, sizeof(T));
+	}
+
+	void WriteName(const FString& Name, int32 Size)
+	{
+		TArray<char> Chars;
+		Chars.SetNumZeroed(Size);
+		FCStringAnsi::Strncpy(Chars.GetData(), TCHAR_TO_ANSI(*Name), Size);
+		Write(Chars.GetData(), Size);
+	}
+
+	void WriteVector(const FVector3f& Vector)
+	{
+		Write(Vector.X);
+		Write(Vector.Y);
+		Write(Vector.Z);
+	}
+
+	void WriteQuat(const FQuat4f& Quat)
+	{
+		Write(Quat.X);
+		Write(Quat.Y);
+		Write(Quat.Z);
+		Write(Quat.W);
+	}
+
+	bool Save(const FString& Filename) const
+	{
+		return FFileHelper::SaveArrayToFile(Buffer, *Filename);
+	}
+
+private:
+	TArray64<uint8> Buffer;
+};
+
+static FVector3f RandomPoint(FRandomStream& Random)
+{
+	return FVector3f(Random.FRandRange(-100.f, 100.f), Random.FRandRange(-100.f, 100.f), Random.FRandRange(0.f, 200.f));
+}
+
+static FQuat4f RandomRotation(FRandomStream& Random)
+{
+	return FQuat4f(FRotator3f(Random.FRandRange(-180.f, 180.f), Random.FRandRange(-180.f, 180.f), Random.FRandRange(-180.f, 180.f)));
+}
+
+static void WriteMeshChunks(FActorXFileWriter& Writer, const FActorXSyntheticParams& Params, FRandomStream& Random)
+{
+	Writer.BeginChunk("ACTRHEAD", 0, 0);
+
+	Writer.BeginChunk("PNTS0000", sizeof(FVector3f), Params.Vertices);
+	for (auto i = 0; i < Params.Vertices; i++)
+	{
+		Writer.WriteVector(RandomPoint(Random));
+	}
+
+	// Wedges reuse the points in order
+	Writer.BeginChunk("VTXW0000", sizeof(VVertex), Params.Wedges);
+	for (auto i = 0; i < Params.Wedges; i++)
+	{
+		Writer.Write<int32>(Params.Vertices > 0 ? i % Params.Vertices : 0);
+		Writer.Write(Random.GetFraction());
+		Writer.Write(Random.GetFraction());
+		Writer.Write(static_cast<int8>(Random.RandHelper(Params.Materials)));
+		Writer.Write<int8>(0);
+		Writer.Write<int16>(0);
+	}
+
+	const auto bWideFaces = Params.Wedges > MAX_uint16 + 1;
+	Writer.BeginChunk(bWideFaces ? "FACE3200" : "FACE0000", bWideFaces ? 18 : 12, Params.Faces);
+	for (auto i = 0; i < Params.Faces; i++)
+	{
+		for (auto Corner = 0; Corner < 3; Corner++)
+		{
+			const auto WedgeIndex = Random.RandHelper(Params.Wedges);
+			if (bWideFaces)
+			{
+				Writer.Write<int32>(WedgeIndex);
+			}
+			else
+			{
+				Writer.Write(static_cast<uint16>(WedgeIndex));
+			}
+		}
+		Writer.Write(static_cast<int8>(Random.RandHelper(Params.Materials)));
+		Writer.Write<int8>(0);
+		Writer.Write<uint32>(1);
+	}
+
+	Writer.BeginChunk("MATT0000", sizeof(VMaterial), Params.Materials);
+	for (auto i = 0; i < Params.Materials; i++)
+	{
+		Writer.WriteName(FString::Printf(TEXT("Material_%d"), i), 64);
+		Writer.Write<int32>(i);
+		for (auto Field = 0; Field < 5; Field++)
+		{
+			Writer.Write<int32>(0);
+		}
+	}
+}
+
+// One chunk per extra UV set
+static void WriteExtraUVs(FActorXFileWriter& Writer, const FActorXSyntheticParams& Params, FRandomStream& Random)
+{
+	for (auto Set = 0; Set < Params.UVSets; Set++)
+	{
+		Writer.BeginChunk("EXTRAUVS", sizeof(FVector2f), Params.Wedges);
+		for (auto i = 0; i < Params.Wedges; i++)
+		{
+			Writer.Write(Random.GetFraction());
+			Writer.Write(Random.GetFraction());
+		}
+	}
+}
+
+bool FActorXSyntheticFiles::WritePSK(const FString& Filename, const FActorXSyntheticParams& Params)
+{
+	FRandomStream Random(Params.Seed);
+	FActorXFileWriter Writer;
+	WriteMeshChunks(Writer, Params, Random);
+
+	// Each bone is parented to the one before it, VNamedBoneBinary is written without the padding FQuat4f adds in memory
+	Writer.BeginChunk("REFSKELT", 120, Params.Bones);
+	for (auto i = 0; i < Params.Bones; i++)
+	{
+		Writer.WriteName(FString::Printf(TEXT("Bone_%d"), i), 64);
+		Writer.Write<int32>(0);
+		Writer.Write<int32>(i + 1 < Params.Bones ? 1 : 0);
+		Writer.Write<int32>(FMath::Max(i - 1, 0));
+		Writer.WriteQuat(RandomRotation(Random));
+		Writer.WriteVector(RandomPoint(Random));
+		for (auto Field = 0; Field < 4; Field++)
+		{
+			Writer.Write(1.f);
+		}
+	}
+
+	Writer.BeginChunk("RAWWEIGHTS", sizeof(VRawBoneInfluence), Params.Vertices * Params.InfluencesPerVertex);
+	for (auto i = 0; i < Params.Vertices; i++)
+	{
+		for (auto Influence = 0; Influence < Params.InfluencesPerVertex; Influence++)
+		{
+			Writer.Write(1.f / Params.InfluencesPerVertex);
+			Writer.Write<int32>(i);
+			Writer.Write<int32>(Random.RandHelper(Params.Bones));
+		}
+	}
+
+	WriteExtraUVs(Writer, Params, Random);
+
+	return Writer.Save(Filename);
+}
+
+bool FActorXSyntheticFiles::WritePSKX(const FString& Filename, const FActorXSyntheticParams& Params)
+{
+	FRandomStream Random(Params.Seed);
+	FActorXFileWriter Writer;
+	WriteMeshChunks(Writer, Params, Random);
+
+	Writer.BeginChunk("VTXNORMS", sizeof(FVector3f), Params.Vertices);
+	for (auto i = 0; i < Params.Vertices; i++)
+	{
+		Writer.WriteVector(FVector3f(Random.GetUnitVector()));
+	}
+
+	Writer.BeginChunk("VERTEXCOLOR", sizeof(FColor), Params.Wedges);
+	for (auto i = 0; i < Params.Wedges; i++)
+	{
+		Writer.Write<uint32>(Random.GetUnsignedInt());
+	}
+
+	WriteExtraUVs(Writer, Params, Random);
+
+	return Writer.Save(Filename);
+}
+
+bool FActorXSyntheticFiles::WritePSA(const FString& Filename, const FActorXSyntheticParams& Params)
+{
+	FRandomStream Random(Params.Seed);
+	FActorXFileWriter Writer;
+	Writer.BeginChunk("ANIMHEAD", 0, 0);
+
+	Writer.BeginChunk("BONENAMES", 120, Params.Bones);
+	for (auto i = 0; i < Params.Bones; i++)
+	{
+		Writer.WriteName(FString::Printf(TEXT("Bone_%d"), i), 64);
+		Writer.Write<int32>(0);
+		Writer.Write<int32>(i + 1 < Params.Bones ? 1 : 0);
+		Writer.Write<int32>(FMath::Max(i - 1, 0));
+		Writer.WriteQuat(FQuat4f::Identity);
+		Writer.WriteVector(FVector3f::ZeroVector);
+		for (auto Field = 0; Field < 4; Field++)
+		{
+			Writer.Write(1.f);
+		}
+	}
+
+	Writer.BeginChunk("ANIMINFO", sizeof(VAnimInfoBinary), Params.Sequences);
+	for (auto i = 0; i < Params.Sequences; i++)
+	{
+		Writer.WriteName(FString::Printf(TEXT("Sequence_%d"), i), 64);
+		Writer.WriteName(TEXT("None"), 64);
+		Writer.Write<int32>(Params.Bones);
+		Writer.Write<int32>(0);
+		Writer.Write<int32>(0);
+		Writer.Write<int32>(Params.Bones * Params.Frames);
+		Writer.Write(0.f);
+		Writer.Write(static_cast<float>(Params.Frames));
+		Writer.Write(30.f);
+		Writer.Write<int32>(0);
+		Writer.Write<int32>(i * Params.Frames);
+		Writer.Write<int32>(Params.Frames);
+	}
+
+	const auto NumKeys = Params.Sequences * Params.Frames * Params.Bones;
+
+	// VQuatAnimKey is written without the padding FQuat4f adds in memory
+	Writer.BeginChunk("ANIMKEYS", 32, NumKeys);
+	for (auto i = 0; i < NumKeys; i++)
+	{
+		Writer.WriteVector(RandomPoint(Random));
+		Writer.WriteQuat(RandomRotation(Random));
+		Writer.Write(1.f);
+	}
+
+	Writer.BeginChunk("SCALEKEYS", sizeof(VAnimScaleKey), NumKeys);
+	for (auto i = 0; i < NumKeys; i++)
+	{
+		Writer.WriteVector(FVector3f(Random.FRandRange(0.5f, 2.f)));
+		Writer.Write(1.f);
+	}
+
+	return Writer.Save(Filename);
+}
+
+bool FActorXSyntheticFiles::WriteProps(const FString& Filename, const FActorXSyntheticParams& Params)
+{
+	FActorXFileWriter Writer;
+	Writer.BeginChunk("ACTRHEAD", 0, 0);
+	if (!Writer.Save(Filename))
+	{
+		return false;
+	}
+
+	// Laid out the way UModel writes them, one key per line
+	FRandomStream Random(Params.Seed);
+	FString Props = FString::Printf(TEXT("Sockets[%d] =\n{\n"), Params.Sockets);
+	for (auto i = 0; i < Params.Sockets; i++)
+	{
+		const auto Location = RandomPoint(Random);
+		Props += FString::Printf(TEXT("\tSockets[%d] =\n\t{\n"), i);
+		Props += FString::Printf(TEXT("\t\tSocketName = Socket_%d\n"), i);
+		Props += FString::Printf(TEXT("\t\tBoneName = Bone_%d\n"), Random.RandHelper(FMath::Max(Params.Bones, 1)));
+		Props += FString::Printf(TEXT("\t\tRelativeLocation = { X=%f, Y=%f, Z=%f }\n"), Location.X, Location.Y, Location.Z);
+		Props += FString::Printf(TEXT("\t\tRelativeRotation = { Pitch=%f, Yaw=%f, Roll=%f }\n"), Random.FRandRange(-180.f, 180.f), Random.FRandRange(-180.f, 180.f), Random.FRandRange(-180.f, 180.f));
+		Props += TEXT("\t\tRelativeScale = { X=1.000000, Y=1.000000, Z=1.000000 }\n");
+		Props += TEXT("\t}\n");
+	}
+	Props += TEXT("}\n");
+
+	return FFileHelper::SaveStringToFile(Props, *FPaths::ChangeExtension(Filename, TEXT("props.txt")));
+}
+
+void FActorXSyntheticParams::ParseCommandLine(const TCHAR* CommandLine)
+{
+	FParse::Value(CommandLine, TEXT("-Vertices="), Vertices);
+	FParse::Value(CommandLine, TEXT("-Wedges="), Wedges);
+	FParse::Value(CommandLine, TEXT("-Faces="), Faces);
+	FParse::Value(CommandLine, TEXT("-Materials="), Materials);
+	FParse::Value(CommandLine, TEXT("-UVSets="), UVSets);
+	FParse::Value(CommandLine, TEXT("-Influences="), InfluencesPerVertex);
+	FParse::Value(CommandLine, TEXT("-Bones="), Bones);
+	FParse::Value(CommandLine, TEXT("-Sockets="), Sockets);
+	FParse::Value(CommandLine, TEXT("-Sequences="), Sequences);
+	FParse::Value(CommandLine, TEXT("-Frames="), Frames);
+	FParse::Value(CommandLine, TEXT("-Seed="), Seed);
+
+	// Every index in the files has to point at something
+	Vertices = FMath::Max(Vertices, 1);
+	Wedges = FMath::Max(Wedges, 1);
+	Materials = FMath::Clamp(Materials, 1, MAX_int8);
+	Bones = FMath::Max(Bones, 1);
+}
+
+FString FActorXSyntheticParams::ToString() const
+{
+	return FString::Printf(TEXT("%d vertices, %d wedges, %d faces, %d materials, %d UV sets, %d influences per vertex, %d bones, %d sockets, %d sequences of %d frames"),
+		Vertices, Wedges, Faces, Materials, UVSets, InfluencesPerVertex, Bones, Sockets, Sequences, Frames);
+}
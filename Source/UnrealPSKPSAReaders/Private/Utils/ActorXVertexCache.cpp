@@ -0,0 +1,264 @@
+#include "Utils/ActorXVertexCache.h"
+#include "Readers/ActorXTrace.h"
+
+// Weights from Forsyth's paper
+static constexpr float CacheDecayPower = 1.5f;
+static constexpr float LastTriangleScore = 0.75f;
+static constexpr float ValenceBoostScale = 2.f;
+static constexpr float ValenceBoostPower = 0.5f;
+
+static float ScoreVertex(int32 CachePosition, int32 RemainingValence)
+{
+	// Vertices without triangles left don't matter
+	if (RemainingValence == 0)
+	{
+		return -1.f;
+	}
+
+	auto Score = 0.f;
+	if (CachePosition >= 0)
+	{
+		// The last triangle's vertices get a fixed score so its edges aren't favoured over the rest of the cache
+		if (CachePosition < 3)
+		{
+			Score = LastTriangleScore;
+		}
+		else
+		{
+			const auto Scaler = 1.f / (FActorXVertexCache::CacheSize - 3);
+			Score = FMath::Pow(1.f - (CachePosition - 3) * Scaler, CacheDecayPower);
+		}
+	}
+
+	// Vertices with few triangles left are finished first so they don't become lone triangles later on
+	return Score + ValenceBoostScale * FMath::Pow(static_cast<float>(RemainingValence), -ValenceBoostPower);
+}
+
+void FActorXVertexCache::OptimizeFaceOrder(TConstArrayView<int32> CornerVertices, TConstArrayView<int32> Sections, TArray<int32>& OutOrder, EParallelForFlags Flags)
+{
+	ACTORX_TRACE_SCOPE("ActorX.OptimizeVertexCache");
+
+	const auto NumTriangles = Sections.Num();
+	check(CornerVertices.Num() == NumTriangles * 3);
+
+	// Stable counting sort of the triangles into their sections
+	auto MaxSection = -1;
+	for (const auto Section : Sections)
+	{
+		MaxSection = FMath::Max(MaxSection, Section);
+	}
+
+	TArray<int32> SectionOffsets;
+	SectionOffsets.SetNumZeroed(MaxSection + 2);
+	for (const auto Section : Sections)
+	{
+		SectionOffsets[Section + 1]++;
+	}
+
+	for (auto i = 1; i < SectionOffsets.Num(); i++)
+	{
+		SectionOffsets[i] += SectionOffsets[i - 1];
+	}
+
+	OutOrder.SetNumUninitialized(NumTriangles);
+	{
+		auto Next = SectionOffsets;
+		for (auto Triangle = 0; Triangle < NumTriangles; Triangle++)
+		{
+			OutOrder[Next[Sections[Triangle]]++] = Triangle;
+		}
+	}
+
+	ParallelFor(MaxSection + 1, [&](int32 Section)
+	{
+		const auto SectionOrder = TArrayView<int32>(OutOrder).Slice(SectionOffsets[Section], SectionOffsets[Section + 1] - SectionOffsets[Section]);
+		if (SectionOrder.Num() < 2)
+		{
+			return;
+		}
+
+		// Renumber the section's vertices so the working arrays only cover what it uses
+		TMap<int32, int32> LocalVertices;
+		TArray<int32> LocalCorners;
+		LocalCorners.SetNumUninitialized(SectionOrder.Num() * 3);
+		for (auto i = 0; i < SectionOrder.Num(); i++)
+		{
+			for (auto Corner = 0; Corner < 3; Corner++)
+			{
+				LocalCorners[i * 3 + Corner] = LocalVertices.FindOrAdd(CornerVertices[SectionOrder[i] * 3 + Corner], LocalVertices.Num());
+			}
+		}
+
+		TArray<int32> LocalOrder;
+		OptimizeSection(LocalCorners, LocalVertices.Num(), LocalOrder);
+
+		const TArray<int32> SectionTriangles(SectionOrder.GetData(), SectionOrder.Num());
+		for (auto i = 0; i < LocalOrder.Num(); i++)
+		{
+			SectionOrder[i] = SectionTriangles[LocalOrder[i]];
+		}
+	}, Flags);
+}
+
+void FActorXVertexCache::OptimizeSection(TConstArrayView<int32> CornerVertices, int32 NumVertices, TArray<int32>& OutOrder)
+{
+	const auto NumTriangles = CornerVertices.Num() / 3;
+
+	// Triangles of every vertex
+	TArray<int32> RemainingValence;
+	RemainingValence.SetNumZeroed(NumVertices);
+	for (const auto Vertex : CornerVertices)
+	{
+		RemainingValence[Vertex]++;
+	}
+
+	TArray<int32> AdjacencyOffsets;
+	AdjacencyOffsets.SetNumUninitialized(NumVertices + 1);
+	AdjacencyOffsets[0] = 0;
+	for (auto Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		AdjacencyOffsets[Vertex + 1] = AdjacencyOffsets[Vertex] + RemainingValence[Vertex];
+	}
+
+	TArray<int32> Adjacency;
+	Adjacency.SetNumUninitialized(CornerVertices.Num());
+	{
+		auto Next = AdjacencyOffsets;
+		for (auto i = 0; i < CornerVertices.Num(); i++)
+		{
+			Adjacency[Next[CornerVertices[i]]++] = i / 3;
+		}
+	}
+
+	TArray<int32> CachePositions;
+	CachePositions.Init(INDEX_NONE, NumVertices);
+
+	TArray<float> VertexScores;
+	VertexScores.SetNumUninitialized(NumVertices);
+	for (auto Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		VertexScores[Vertex] = ScoreVertex(INDEX_NONE, RemainingValence[Vertex]);
+	}
+
+	TBitArray<> Added(false, NumTriangles);
+	TArray<float> TriangleScores;
+	TriangleScores.SetNumUninitialized(NumTriangles);
+
+	auto BestTriangle = INDEX_NONE;
+	auto BestScore = -1.f;
+	for (auto Triangle = 0; Triangle < NumTriangles; Triangle++)
+	{
+		TriangleScores[Triangle] = VertexScores[CornerVertices[Triangle * 3]] + VertexScores[CornerVertices[Triangle * 3 + 1]] + VertexScores[CornerVertices[Triangle * 3 + 2]];
+		if (TriangleScores[Triangle] > BestScore)
+		{
+			BestScore = TriangleScores[Triangle];
+			BestTriangle = Triangle;
+		}
+	}
+
+	// The cache holds the triangle just added in front of the previous entries, the extra three are the ones pushed out
+	TArray<int32, TInlineAllocator<CacheSize + 3>> Cache;
+	TArray<int32, TInlineAllocator<CacheSize + 3>> NewCache;
+
+	OutOrder.Reset(NumTriangles);
+	auto NextUnadded = 0;
+	while (OutOrder.Num() < NumTriangles)
+	{
+		// Nothing around the cache is left, continue with the first triangle not added yet
+		if (BestTriangle == INDEX_NONE)
+		{
+			while (Added[NextUnadded])
+			{
+				NextUnadded++;
+			}
+
+			BestTriangle = NextUnadded;
+		}
+
+		OutOrder.Add(BestTriangle);
+		Added[BestTriangle] = true;
+
+		NewCache.Reset();
+		for (auto Corner = 0; Corner < 3; Corner++)
+		{
+			const auto Vertex = CornerVertices[BestTriangle * 3 + Corner];
+			RemainingValence[Vertex]--;
+			NewCache.Add(Vertex);
+		}
+
+		for (const auto Vertex : Cache)
+		{
+			if (!NewCache.Contains(Vertex))
+			{
+				NewCache.Add(Vertex);
+			}
+		}
+
+		// Rescore everything that moved in the cache, including what fell out of it
+		for (auto i = 0; i < NewCache.Num(); i++)
+		{
+			const auto Vertex = NewCache[i];
+			CachePositions[Vertex] = i < CacheSize ? i : INDEX_NONE;
+			VertexScores[Vertex] = ScoreVertex(CachePositions[Vertex], RemainingValence[Vertex]);
+		}
+
+		BestTriangle = INDEX_NONE;
+		BestScore = -1.f;
+		for (const auto Vertex : NewCache)
+		{
+			for (auto i = AdjacencyOffsets[Vertex]; i < AdjacencyOffsets[Vertex + 1]; i++)
+			{
+				const auto Triangle = Adjacency[i];
+				if (Added[Triangle])
+				{
+					continue;
+				}
+
+				TriangleScores[Triangle] = VertexScores[CornerVertices[Triangle * 3]] + VertexScores[CornerVertices[Triangle * 3 + 1]] + VertexScores[CornerVertices[Triangle * 3 + 2]];
+				if (TriangleScores[Triangle] > BestScore)
+				{
+					BestScore = TriangleScores[Triangle];
+					BestTriangle = Triangle;
+				}
+			}
+		}
+
+		Cache.Reset();
+		Cache.Append(NewCache.GetData(), FMath::Min(NewCache.Num(), CacheSize));
+	}
+}
+
+double FActorXVertexCache::ComputeACMR(TConstArrayView<int32> CornerVertices, TConstArrayView<int32> Order)
+{
+	const auto NumTriangles = Order.IsEmpty() ? CornerVertices.Num() / 3 : Order.Num();
+	if (NumTriangles == 0)
+	{
+		return 0.0;
+	}
+
+	auto MaxVertex = 0;
+	for (const auto Vertex : CornerVertices)
+	{
+		MaxVertex = FMath::Max(MaxVertex, Vertex);
+	}
+
+	// FIFO cache, a vertex is still in it when fewer than CacheSize misses happened since it was loaded
+	TArray<int64> LoadedAt;
+	LoadedAt.Init(-CacheSize - 1, MaxVertex + 1);
+
+	int64 Misses = 0;
+	for (auto i = 0; i < NumTriangles; i++)
+	{
+		const auto Triangle = Order.IsEmpty() ? i : Order[i];
+		for (auto Corner = 0; Corner < 3; Corner++)
+		{
+			const auto Vertex = CornerVertices[Triangle * 3 + Corner];
+			if (Misses - LoadedAt[Vertex] >= CacheSize)
+			{
+				LoadedAt[Vertex] = Misses++;
+			}
+		}
+	}
+
+	return static_cast<double>(Misses) / NumTriangles;
+}
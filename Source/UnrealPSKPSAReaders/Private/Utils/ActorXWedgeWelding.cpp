@@ -0,0 +1,200 @@
+#include "Utils/ActorXWedgeWelding.h"
+#include "Hash/xxhash.h"
+#include "Readers/ActorXTrace.h"
+#include "Readers/PSKReader.h"
+
+/** Everything that tells two corners apart, with a tolerance the UVs are left out and compared within the point's wedges instead */
+struct FActorXWeldKey
+{
+	int32 PointIndex = 0;
+	int32 MatIndex = 0;
+	int64 UVs[ActorXMaxUVSets * 2] = {};
+
+	bool operator==(const FActorXWeldKey& Other) const
+	{
+		return FMemory::Memcmp(this, &Other, sizeof(FActorXWeldKey)) == 0;
+	}
+
+	friend uint32 GetTypeHash(const FActorXWeldKey& Key)
+	{
+		return static_cast<uint32>(FXxHash64::HashBuffer(&Key, sizeof(FActorXWeldKey)).Hash);
+	}
+};
+
+static int64 GetUVBits(float Value)
+{
+	// -0 and 0 are the same coordinate
+	uint32 Bits = 0;
+	if (Value != 0.f)
+	{
+		FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+	}
+
+	return Bits;
+}
+
+/** Every face of the reader in file order */
+struct FActorXAllFaces
+{
+	const PSKReader& Data;
+
+	int32 Num() const { return Data.Faces.Num(); }
+	const VTriangle& operator[](int32 Index) const { return Data.Faces[Index]; }
+};
+
+/** The given faces of the reader in the order they are listed */
+struct FActorXFaceSubset
+{
+	const PSKReader& Data;
+	TConstArrayView<int32> Faces;
+
+	int32 Num() const { return Faces.Num(); }
+	const VTriangle& operator[](int32 Index) const { return Data.Faces[Faces[Index]]; }
+};
+
+static bool UVsWithinTolerance(const PSKReader& Data, int32 NumExtraUVs, int32 WedgeA, int32 WedgeB, float UVTolerance)
+{
+	const auto& A = Data.Wedges[WedgeA];
+	const auto& B = Data.Wedges[WedgeB];
+	if (FMath::Abs(A.U - B.U) > UVTolerance || FMath::Abs(A.V - B.V) > UVTolerance)
+	{
+		return false;
+	}
+
+	for (auto UVIndex = 0; UVIndex < NumExtraUVs; UVIndex++)
+	{
+		const auto Delta = Data.ExtraUVs[UVIndex][WedgeA] - Data.ExtraUVs[UVIndex][WedgeB];
+		if (FMath::Abs(Delta.X) > UVTolerance || FMath::Abs(Delta.Y) > UVTolerance)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <typename FacesType, typename FuncType>
+static void ForEachFace(const FacesType& Faces, FuncType Func)
+{
+	for (auto FaceIndex = 0; FaceIndex < Faces.Num(); FaceIndex++)
+	{
+		Func(FaceIndex, Faces[FaceIndex]);
+	}
+}
+
+template <typename FacesType>
+static void WeldFaces(const PSKReader& Data, float UVTolerance, const FacesType& Faces, TArray<int32>& OutCornerWedges, TArray<int32>& OutSourceWedges)
+{
+	ACTORX_TRACE_SCOPE("ActorX.WeldWedges");
+
+	const auto NumExtraUVs = FMath::Min(Data.ExtraUVs.Num(), ActorXMaxUVSets - 1);
+	OutCornerWedges.SetNumUninitialized(Faces.Num() * 3);
+	OutSourceWedges.Reset(Data.Wedges.Num());
+
+	// Wedges shared in the file are the same corner whatever their UVs, so each is only keyed once
+	TArray<int32> WeldedWedges;
+	WeldedWedges.Init(INDEX_NONE, Data.Wedges.Num());
+
+	TMap<FActorXWeldKey, int32> Welded;
+	Welded.Reserve(Data.Wedges.Num());
+
+	// With a tolerance the key only holds the point and material, it leads to the first output wedge with them
+	// and the others are chained after it, a point rarely has more than a handful
+	const auto bTolerance = UVTolerance > 0.f;
+	TArray<int32> NextWithKey;
+
+	ForEachFace(Faces, [&](int32 FaceIndex, const VTriangle& Face)
+	{
+		for (auto Corner = 0; Corner < 3; Corner++)
+		{
+			const auto WedgeIndex = Face.WedgeIndex[Corner];
+			auto& WeldedIndex = WeldedWedges[WedgeIndex];
+			if (WeldedIndex == INDEX_NONE)
+			{
+				const auto& Wedge = Data.Wedges[WedgeIndex];
+
+				FActorXWeldKey Key;
+				Key.PointIndex = Wedge.PointIndex;
+				Key.MatIndex = Wedge.MatIndex;
+				if (!bTolerance)
+				{
+					Key.UVs[0] = GetUVBits(Wedge.U);
+					Key.UVs[1] = GetUVBits(Wedge.V);
+					for (auto UVIndex = 0; UVIndex < NumExtraUVs; UVIndex++)
+					{
+						const auto& UV = Data.ExtraUVs[UVIndex][WedgeIndex];
+						Key.UVs[UVIndex * 2 + 2] = GetUVBits(UV.X);
+						Key.UVs[UVIndex * 2 + 3] = GetUVBits(UV.Y);
+					}
+				}
+
+				// The first wedge with a key is the one that is kept
+				WeldedIndex = Welded.FindOrAdd(Key, OutSourceWedges.Num());
+				if (bTolerance && WeldedIndex != OutSourceWedges.Num())
+				{
+					// Corners are compared to the kept wedges and not to each other, so welds don't drift along a chain of close UVs
+					auto Candidate = WeldedIndex;
+					auto Last = INDEX_NONE;
+					while (Candidate != INDEX_NONE && !UVsWithinTolerance(Data, NumExtraUVs, OutSourceWedges[Candidate], WedgeIndex, UVTolerance))
+					{
+						Last = Candidate;
+						Candidate = NextWithKey[Candidate];
+					}
+
+					WeldedIndex = Candidate != INDEX_NONE ? Candidate : OutSourceWedges.Num();
+					if (Candidate == INDEX_NONE)
+					{
+						NextWithKey[Last] = WeldedIndex;
+					}
+				}
+
+				if (WeldedIndex == OutSourceWedges.Num())
+				{
+					OutSourceWedges.Add(WedgeIndex);
+					if (bTolerance)
+					{
+						NextWithKey.Add(INDEX_NONE);
+					}
+				}
+			}
+
+			OutCornerWedges[FaceIndex * 3 + Corner] = WeldedIndex;
+		}
+	});
+}
+
+template <typename FacesType>
+static void MapFaceCorners(const FacesType& Faces, TArray<int32>& OutCornerWedges, TArray<int32>& OutSourceWedges)
+{
+	OutCornerWedges.SetNumUninitialized(Faces.Num() * 3);
+	OutSourceWedges.SetNumUninitialized(OutCornerWedges.Num());
+
+	ForEachFace(Faces, [&](int32 FaceIndex, const VTriangle& Face)
+	{
+		for (auto Corner = 0; Corner < 3; Corner++)
+		{
+			OutCornerWedges[FaceIndex * 3 + Corner] = FaceIndex * 3 + Corner;
+			OutSourceWedges[FaceIndex * 3 + Corner] = Face.WedgeIndex[Corner];
+		}
+	});
+}
+
+void FActorXWedgeWelding::Weld(const PSKReader& Data, float UVTolerance, TArray<int32>& OutCornerWedges, TArray<int32>& OutSourceWedges)
+{
+	WeldFaces(Data, UVTolerance, FActorXAllFaces{ Data }, OutCornerWedges, OutSourceWedges);
+}
+
+void FActorXWedgeWelding::Weld(const PSKReader& Data, float UVTolerance, TConstArrayView<int32> Faces, TArray<int32>& OutCornerWedges, TArray<int32>& OutSourceWedges)
+{
+	WeldFaces(Data, UVTolerance, FActorXFaceSubset{ Data, Faces }, OutCornerWedges, OutSourceWedges);
+}
+
+void FActorXWedgeWelding::MapCorners(const PSKReader& Data, TArray<int32>& OutCornerWedges, TArray<int32>& OutSourceWedges)
+{
+	MapFaceCorners(FActorXAllFaces{ Data }, OutCornerWedges, OutSourceWedges);
+}
+
+void FActorXWedgeWelding::MapCorners(const PSKReader& Data, TConstArrayView<int32> Faces, TArray<int32>& OutCornerWedges, TArray<int32>& OutSourceWedges)
+{
+	MapFaceCorners(FActorXFaceSubset{ Data, Faces }, OutCornerWedges, OutSourceWedges);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Readers/ActorXMappedFile.h"
+
+/**
+ * Table of every chunk in an ActorX file, built by walking only the chunk headers.
+ * Readers use it to decode chunks on demand instead of in a single eager pass.
+ */
+class UNREALPSKPSAREADERS_API FActorXChunkDirectory
+{
+public:
+	/** Maps the file and indexes its chunks, the first chunk has to match HeaderId */
+	bool Open(const FString& Filename, uint64 HeaderId);
+	void Close();
+
+	bool IsOpen() const { return File.IsOpen(); }
+	const TArray<FActorXChunkView>& GetChunks() const { return Chunks; }
+
+	/** Returns the first chunk with the given id, or nullptr if the file doesn't have one */
+	const FActorXChunkView* Find(uint64 ChunkId) const;
+
+	/** Flags a chunk as decoded, returns false if it already was */
+	bool MarkDecoded(int32 ChunkIndex);
+
+private:
+	FActorXMappedFile File;
+	TArray<FActorXChunkView> Chunks;
+	TBitArray<> DecodedChunks;
+};
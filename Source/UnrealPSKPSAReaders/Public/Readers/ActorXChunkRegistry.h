@@ -0,0 +1,146 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Readers/ActorXMappedFile.h"
+#include "Utils/ActorXModels.h"
+
+/**
+ * Decodes records of type T. The primary template handles records stored exactly as they are laid out in memory,
+ * records with a different file layout specialise it with their own RecordSize and DecodeRecord.
+ */
+template <typename T>
+struct TActorXRecordDecoder
+{
+	static constexpr int32 RecordSize = sizeof(T);
+
+	static void DecodeRecord(const uint8* Src, T& Out)
+	{
+		FMemory::Memcpy(&Out, Src, sizeof(T));
+	}
+
+	static bool Decode(const FActorXChunkView& Chunk, TArray<T>& Out)
+	{
+		return Chunk.CopyTo(Out);
+	}
+};
+
+/** Decodes a chunk one record at a time, for records that can't be copied in bulk */
+template <typename T>
+bool DecodeEachRecord(const FActorXChunkView& Chunk, TArray<T>& Out)
+{
+	if (Chunk.DataSize < TActorXRecordDecoder<T>::RecordSize)
+	{
+		return false;
+	}
+
+	Out.SetNum(Chunk.DataCount);
+	for (auto i = 0; i < Chunk.DataCount; i++)
+	{
+		TActorXRecordDecoder<T>::DecodeRecord(Chunk.GetRecord(i), Out[i]);
+	}
+
+	return true;
+}
+
+// FQuat4f is 16 byte aligned, so bones and keys have padding in memory that the file doesn't have
+template <>
+struct TActorXRecordDecoder<VNamedBoneBinary>
+{
+	static constexpr int32 RecordSize = 64 + 3 * sizeof(int32) + sizeof(FQuat4f) + sizeof(FVector3f) + 4 * sizeof(float);
+
+	static void DecodeRecord(const uint8* Src, VNamedBoneBinary& Out)
+	{
+		FActorXRecordCursor Cursor(Src);
+		Cursor.Read(Out.Name);
+		Cursor.Read(Out.Flags);
+		Cursor.Read(Out.NumChildren);
+		Cursor.Read(Out.ParentIndex);
+		Cursor.Read(Out.BonePos.Orientation);
+		Cursor.Read(Out.BonePos.Position);
+
+		Cursor.Read(Out.BonePos.Length);
+		Cursor.Read(Out.BonePos.XSize);
+		Cursor.Read(Out.BonePos.YSize);
+		Cursor.Read(Out.BonePos.ZSize);
+	}
+
+	static bool Decode(const FActorXChunkView& Chunk, TArray<VNamedBoneBinary>& Out)
+	{
+		return DecodeEachRecord(Chunk, Out);
+	}
+};
+
+template <>
+struct TActorXRecordDecoder<VQuatAnimKey>
+{
+	static constexpr int32 RecordSize = sizeof(FVector3f) + sizeof(FQuat4f) + sizeof(float);
+
+	static void DecodeRecord(const uint8* Src, VQuatAnimKey& Out)
+	{
+		FActorXRecordCursor Cursor(Src);
+		Cursor.Read(Out.Position);
+		Cursor.Read(Out.Orientation);
+		Cursor.Read(Out.Time);
+	}
+
+	static bool Decode(const FActorXChunkView& Chunk, TArray<VQuatAnimKey>& Out)
+	{
+		return DecodeEachRecord(Chunk, Out);
+	}
+};
+
+/** Entry of a reader's chunk dispatch table */
+template <typename TReader>
+struct TActorXChunkDecoder
+{
+	using FDecodeFunc = bool (*)(TReader& Reader, const FActorXChunkView& Chunk);
+
+	uint64 ChunkId;
+	FDecodeFunc Decode;
+};
+
+/** Decoder that fills one of the reader's arrays straight from the chunk */
+template <typename TReader, typename TRecord, TArray<TRecord> TReader::*Member>
+bool DecodeChunkInto(TReader& Reader, const FActorXChunkView& Chunk)
+{
+	return TActorXRecordDecoder<TRecord>::Decode(Chunk, Reader.*Member);
+}
+
+/**
+ * Looks up chunk decoders for a reader. Each reader has a constexpr table of the chunks it knows about,
+ * other chunk types (morph targets, UModel extensions, ...) can be registered at runtime without touching the readers.
+ * Readers own a single registry in their translation unit so registrations are shared across modules.
+ */
+template <typename TReader>
+class TActorXChunkRegistry
+{
+public:
+	using FDecodeFunc = typename TActorXChunkDecoder<TReader>::FDecodeFunc;
+
+	void Register(uint64 ChunkId, FDecodeFunc Decode)
+	{
+		RegisteredDecoders.Add(ChunkId, Decode);
+	}
+
+	void Unregister(uint64 ChunkId)
+	{
+		RegisteredDecoders.Remove(ChunkId);
+	}
+
+	/** Finds the decoder for a chunk, the reader's own table wins over registered decoders */
+	FDecodeFunc Find(uint64 ChunkId, TConstArrayView<TActorXChunkDecoder<TReader>> BuiltInDecoders) const
+	{
+		for (const auto& Decoder : BuiltInDecoders)
+		{
+			if (Decoder.ChunkId == ChunkId)
+			{
+				return Decoder.Decode;
+			}
+		}
+
+		const auto Registered = RegisteredDecoders.Find(ChunkId);
+		return Registered ? *Registered : nullptr;
+	}
+
+private:
+	TMap<uint64, FDecodeFunc> RegisteredDecoders;
+};
@@ -0,0 +1,24 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Readers/ActorXMappedFile.h"
+#include "Utils/ActorXModels.h"
+
+/**
+ * Bulk decoders for the index data of PSK files. Indices are widened and range checked with SIMD where the
+ * platform supports it, every decoder returns false if an index points outside of the data it references.
+ */
+class UNREALPSKPSAREADERS_API FActorXIndexDecoder
+{
+public:
+	/** Decodes FACE0000 records, widening their 16 bit wedge indices */
+	static bool DecodeFaces16(const FActorXChunkView& Chunk, int32 NumWedges, TArray<VTriangle>& OutFaces);
+
+	/** Decodes FACE3200 records */
+	static bool DecodeFaces32(const FActorXChunkView& Chunk, int32 NumWedges, TArray<VTriangle>& OutFaces);
+
+	/** Decodes VTXW0000 records, point indices are masked to 16 bits for meshes with up to 65536 wedges */
+	static bool DecodeWedges(const FActorXChunkView& Chunk, int32 NumPoints, TArray<VVertex>& OutWedges);
+
+	static constexpr int32 Face16RecordSize = 3 * sizeof(uint16) + 2 * sizeof(char) + sizeof(unsigned);
+	static constexpr int32 Face32RecordSize = 3 * sizeof(int32) + 2 * sizeof(char) + sizeof(unsigned);
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Utils/ActorXModels.h"
+#include <type_traits>
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * A single chunk of a mapped ActorX file. The data pointer points straight into the mapped bytes,
+ * so it is only valid for as long as the owning FActorXMappedFile is open.
+ */
+struct FActorXChunkView
+{
+	/** First eight characters of the chunk name, see ActorXChunkId */
+	uint64 Id = 0;
+
+	char ChunkID[20];
+	int32 TypeFlag = 0;
+	int32 DataSize = 0;
+	int32 DataCount = 0;
+
+	/** Offset of the chunk data from the start of the file */
+	int64 Offset = 0;
+	const uint8* Data = nullptr;
+
+	bool Is(uint64 ChunkId) const
+	{
+		return Id == ChunkId;
+	}
+
+	int64 GetDataBytes() const
+	{
+		return static_cast<int64>(DataSize) * DataCount;
+	}
+
+	const uint8* GetRecord(int64 Index) const
+	{
+		return Data + Index * DataSize;
+	}
+
+	/** Typed view over the mapped bytes, only valid when the records are stored exactly as T is laid out in memory */
+	template <typename T>
+	TArrayView<const T> GetView() const
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Chunk views can only be created for plain-old-data records");
+		if (DataSize != sizeof(T))
+		{
+			return TArrayView<const T>();
+		}
+
+		return TArrayView<const T>(reinterpret_cast<const T*>(Data), DataCount);
+	}
+
+	/** Copies a plain-old-data chunk into an array, in one block when the record size matches */
+	template <typename T>
+	bool CopyTo(TArray<T>& Out) const
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Only plain-old-data records can be copied in bulk");
+		if (DataSize < static_cast<int32>(sizeof(T)))
+		{
+			return false;
+		}
+
+		Out.SetNumUninitialized(DataCount);
+		if (DataSize == sizeof(T))
+		{
+			FMemory::Memcpy(Out.GetData(), Data, GetDataBytes());
+		}
+		else
+		{
+			for (auto i = 0; i < DataCount; i++)
+			{
+				FMemory::Memcpy(&Out[i], GetRecord(i), sizeof(T));
+			}
+		}
+
+		return true;
+	}
+};
+
+/** Field by field reader for records whose file layout doesn't match their in-memory layout */
+struct FActorXRecordCursor
+{
+	explicit FActorXRecordCursor(const uint8* InPtr) : Ptr(InPtr) {}
+
+	template <typename T>
+	void Read(T& Out)
+	{
+		FMemory::Memcpy(&Out, Ptr, sizeof(T));
+		Ptr += sizeof(T);
+	}
+
+	const uint8* Ptr;
+};
+
+/**
+ * Maps a whole ActorX file into memory so chunks can be decoded without per-element stream reads.
+ * Falls back to loading the file into memory on platforms that don't support mapped files.
+ */
+class UNREALPSKPSAREADERS_API FActorXMappedFile
+{
+public:
+	FActorXMappedFile();
+	~FActorXMappedFile();
+
+	bool Open(const FString& Filename);
+	void Close();
+
+	bool IsOpen() const { return Data != nullptr; }
+	const uint8* GetData() const { return Data; }
+	int64 GetSize() const { return Size; }
+
+	/** Reads the chunk header at Offset and moves Offset past the chunk data, returns false at the end of the file */
+	bool NextChunk(int64& Offset, FActorXChunkView& OutChunk) const;
+
+private:
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray64<uint8> LoadedData;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+};
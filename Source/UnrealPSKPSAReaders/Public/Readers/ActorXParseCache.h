@@ -0,0 +1,51 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Readers/ActorXMappedFile.h"
+#include "Utils/ActorXModels.h"
+
+class PSKReader;
+class PSAReader;
+struct FPSABoneTrack;
+
+/**
+ * Local cache of converted ActorX data, keyed by a hash of the file contents and the reader version.
+ * Entries hold the data after FActorXConversion, so a hit skips both the chunk decoding and the conversion.
+ * Properties files aren't cached, they are small and always read from next to the source file.
+ */
+class UNREALPSKPSAREADERS_API FActorXParseCache
+{
+public:
+	/** Bump whenever the decoded or converted data changes, entries written by other versions are ignored */
+	static constexpr uint32 ReaderVersion = 1;
+
+	static bool IsEnabled();
+
+	/** Hashes the contents of the file, returns an empty key if it can't be read */
+	static FString MakeKey(const FString& Filename);
+
+	static FString GetEntryFilename(const FString& Key);
+
+	static bool LoadMesh(const FString& Key, PSKReader& Reader);
+	static bool SaveMesh(const FString& Key, const PSKReader& Reader);
+
+	/** Decodes and converts every sequence of an opened reader into a new entry, one batch of sequences at a time */
+	static bool SaveAnim(const FString& Key, const PSAReader& Reader);
+};
+
+/** A mapped animation entry, tracks are copied out of it on demand so sequences can still be read in parallel */
+class UNREALPSKPSAREADERS_API FActorXAnimCacheEntry
+{
+public:
+	bool Open(const FString& Key, TArray<VAnimInfoBinary>& OutAnimInfo, TArray<VNamedBoneBinary>& OutBones);
+	void Close();
+
+	bool IsOpen() const { return File.IsOpen(); }
+
+	/** Same layout as PSAReader::ReadSequenceTracks, but already converted */
+	bool ReadTracks(int32 SequenceIndex, TArray<FPSABoneTrack>& OutTracks) const;
+
+private:
+	FActorXMappedFile File;
+	TArray<int64> SequenceOffsets;
+	int32 NumBones = 0;
+};
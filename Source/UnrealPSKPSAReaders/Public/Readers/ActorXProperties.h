@@ -0,0 +1,60 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * A single property of a UModel properties file. Values keep their text and are converted when they are queried,
+ * structs and arrays hold their fields or elements as children.
+ */
+struct UNREALPSKPSAREADERS_API FActorXProperty
+{
+	enum class EType : uint8
+	{
+		Value,
+		Struct,
+		Array
+	};
+
+	FString Name;
+	EType Type = EType::Value;
+
+	/** Position in the owning array, INDEX_NONE for anything that isn't an array element */
+	int32 Index = INDEX_NONE;
+
+	FString Value;
+	TArray<FActorXProperty> Children;
+
+	bool IsStruct() const { return Type == EType::Struct; }
+	bool IsArray() const { return Type == EType::Array; }
+
+	/** Returns the first child with the given name, names are case insensitive like in the engine */
+	const FActorXProperty* Find(FStringView ChildName) const;
+
+	/** Typed lookups of a child, they return false and leave Out untouched if the child doesn't exist or can't be converted */
+	bool TryGet(FStringView ChildName, FString& Out) const;
+	bool TryGet(FStringView ChildName, bool& Out) const;
+	bool TryGet(FStringView ChildName, int64& Out) const;
+	bool TryGet(FStringView ChildName, double& Out) const;
+	bool TryGet(FStringView ChildName, FVector& Out) const;
+	bool TryGet(FStringView ChildName, FRotator& Out) const;
+};
+
+/**
+ * Properties exported by UModel next to a mesh or animation as <name>.props.txt.
+ * The file is tokenized in a single pass over its bytes, nested structs and arrays become a tree of FActorXProperty.
+ */
+class UNREALPSKPSAREADERS_API FActorXProperties
+{
+public:
+	/** Returns false if the file can't be read, malformed lines are only logged */
+	bool Load(const FString& Filename);
+
+	/** Parses UTF-8 text, lines that can't be parsed are skipped and make it return false */
+	bool Parse(const ANSICHAR* Text, int64 Length);
+
+	bool IsEmpty() const { return Root.Children.IsEmpty(); }
+	const FActorXProperty& GetRoot() const { return Root; }
+	const FActorXProperty* Find(FStringView Name) const { return Root.Find(Name); }
+
+private:
+	FActorXProperty Root { FString(), FActorXProperty::EType::Struct };
+};
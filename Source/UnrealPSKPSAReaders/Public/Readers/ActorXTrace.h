@@ -0,0 +1,34 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Readers/ActorXMappedFile.h"
+
+/** Trace channel for everything the ActorX readers and importers do, enable it with -trace=cpu,actorx */
+UE_TRACE_CHANNEL_EXTERN(ActorXChannel, UNREALPSKPSAREADERS_API);
+
+#define ACTORX_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(TEXT(Name), ActorXChannel)
+
+/** Size and decode time of one decoded chunk */
+struct FActorXChunkStats
+{
+	FString ChunkID;
+	int64 Bytes = 0;
+	int32 Elements = 0;
+	double Seconds = 0.0;
+};
+
+/** Times a chunk decode for the reader's stats and adds it to the trace counters */
+class UNREALPSKPSAREADERS_API FActorXChunkTimer
+{
+public:
+	FActorXChunkTimer(const FActorXChunkView& InChunk, TArray<FActorXChunkStats>& InStats);
+	~FActorXChunkTimer();
+
+private:
+	const FActorXChunkView& Chunk;
+	TArray<FActorXChunkStats>& Stats;
+	uint64 StartCycles;
+};
+
+/** Adds bytes and records read outside of a chunk decode, e.g. keys streamed per sequence, to the trace counters */
+UNREALPSKPSAREADERS_API void ActorXTraceDecoded(int64 Bytes, int64 Records);
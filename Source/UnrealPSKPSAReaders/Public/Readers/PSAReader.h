@@ -0,0 +1,87 @@
+#pragma once
+#include "Readers/ActorXChunkDirectory.h"
+#include "Readers/ActorXChunkRegistry.h"
+#include "Readers/ActorXParseCache.h"
+#include "Readers/ActorXProperties.h"
+#include "Readers/ActorXTrace.h"
+#include "Utils/ActorXModels.h"
+
+/** Keys of a single bone for one sequence, laid out contiguously per track */
+struct FPSABoneTrack
+{
+	TArray<FVector3f> PositionalKeys;
+	TArray<FQuat4f> RotationalKeys;
+	TArray<FVector3f> ScaleKeys;
+};
+
+class UNREALPSKPSAREADERS_API PSAReader
+{
+public:
+	PSAReader(const FString Filename, bool bLoadPropertiesFile = false);
+
+	/** Reads the whole file in one go */
+	bool Read();
+
+	/** Indexes the chunks of the file without decoding any of them */
+	bool Open();
+	void Close();
+
+	/** Decodes every chunk with the given id, the file has to be opened first */
+	bool ReadChunk(uint64 ChunkId);
+
+	const FActorXChunkDirectory& GetDirectory() const { return Directory; }
+	const FString& GetFileName() const { return FileName; }
+
+	/** Registers a decoder for a chunk type the reader doesn't handle itself */
+	static void RegisterChunkDecoder(uint64 ChunkId, TActorXChunkDecoder<PSAReader>::FDecodeFunc Decode);
+	static void UnregisterChunkDecoder(uint64 ChunkId);
+
+	/** Number of bones in the file, available as soon as the file is opened */
+	int32 GetNumBones() const;
+
+	/**
+	 * Decodes the keys of a single sequence transposed to one track per bone, only whole frames are returned.
+	 * Sequences without scale keys get a scale of one for every frame.
+	 */
+	bool ReadSequenceTracks(const VAnimInfoBinary& Info, TArray<FPSABoneTrack>& OutTracks) const;
+
+	/**
+	 * Opens the file and reads the sequence table and bones through the parse cache.
+	 * On a miss every sequence is decoded and converted into a new cache entry once, and read back from it afterwards.
+	 */
+	bool OpenConverted();
+
+	/** Tracks of a sequence in Unreal's coordinate system, copied from the cache entry when there is one */
+	bool ReadConvertedTracks(int32 SequenceIndex, TArray<FPSABoneTrack>& OutTracks) const;
+
+	/** Mirrors the positions and flips the rotations of the tracks of one sequence, the first track is the root bone */
+	static void ConvertTracks(TArrayView<FPSABoneTrack> Tracks);
+
+	// Switches
+	bool bHasScaleKeys = false;
+	bool bLoadProperties;
+	bool bFromCache = false;
+	
+	// PSA
+	TArray<VAnimInfoBinary> AnimInfo;
+	TArray<VNamedBoneBinary> Bones;
+	TArray<VQuatAnimKey> AnimKeys;
+	TArray<VAnimScaleKey> ScaleKeys;
+
+	// UModel Properties
+	FActorXProperties Properties;
+
+	// Size and decode time of every chunk decoded so far
+	TArray<FActorXChunkStats> ChunkStats;
+
+private:
+	/** Handles loading UModel property files */
+	bool ReadPropertiesFile();
+
+	bool DecodeChunk(const FActorXChunkView& Chunk);
+
+	FString FileName;
+	FActorXChunkDirectory Directory;
+	FActorXAnimCacheEntry CacheEntry;
+
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include "Readers/ActorXChunkDirectory.h"
+#include "Readers/ActorXChunkRegistry.h"
+#include "Readers/ActorXParseCache.h"
+#include "Readers/ActorXProperties.h"
+#include "Readers/ActorXTrace.h"
+#include "Utils/ActorXModels.h"
+
+struct Socket
+{
+	FString SocketName;
+	FString BoneName;
+	FVector RelativeLocation;
+	FRotator RelativeRotation;
+	FVector RelativeScale;
+};
+
+class UNREALPSKPSAREADERS_API PSKReader
+{
+	
+public:
+	PSKReader(const FString Filename, bool bLoadPropertiesFile = false);
+
+	/** Reads the whole file in one go */
+	bool Read();
+
+	/** Reads the whole file and converts it, a hit in the parse cache skips both */
+	bool ReadConverted();
+
+	/**
+	 * Converts the mesh to Unreal's coordinate system, does nothing if it already is.
+	 * Points and normals are mirrored, faces have their winding reversed to match and vertex colors are swizzled from BGRA.
+	 */
+	void Convert();
+
+	/**
+	 * Merges materials with the same name, which resolve to the same material asset, into the first of them.
+	 * Faces and wedges are remapped and the faces are stably grouped by material so every merged section is contiguous.
+	 * Returns the number of materials removed, running it again does nothing.
+	 */
+	int32 MergeMaterials();
+
+	/** Indexes the chunks of the file without decoding any of them */
+	bool Open();
+	void Close();
+
+	/** Decodes every chunk with the given id, the file has to be opened first */
+	bool ReadChunk(uint64 ChunkId);
+
+	const FActorXChunkDirectory& GetDirectory() const { return Directory; }
+	const FString& GetFileName() const { return FileName; }
+
+	/** Registers a decoder for a chunk type the reader doesn't handle itself */
+	static void RegisterChunkDecoder(uint64 ChunkId, TActorXChunkDecoder<PSKReader>::FDecodeFunc Decode);
+	static void UnregisterChunkDecoder(uint64 ChunkId);
+
+	// Switches
+	bool bHasVertexNormals = false;
+	bool bHasVertexColors = false;
+	bool bHasExtraUVs = false;
+	bool bLoadProperties;
+	bool bConverted = false;
+	bool bFromCache = false;
+
+	// PSKX
+	TArray<FVector3f> Vertices;
+	TArray<VVertex> Wedges;
+	TArray<VTriangle> Faces;
+	TArray<VMaterial> Materials;
+	TArray<FVector3f> Normals;
+	TArray<FColor> VertexColors;
+	TArray<TArray<FVector2f>> ExtraUVs;
+
+	// Bounds of the converted points
+	FBox3f Bounds = FBox3f(ForceInit);
+
+	// PSK
+	TArray<VNamedBoneBinary> Bones;
+	TArray<VRawBoneInfluence> Influences;
+
+	// UModel Properties
+	FActorXProperties Properties;
+	TArray<Socket> Sockets;
+
+	// Size and decode time of every chunk decoded so far
+	TArray<FActorXChunkStats> ChunkStats;
+
+private:
+	/** Handles loading UModel property files */
+	bool ReadPropertiesFile();
+
+	bool DecodeChunk(const FActorXChunkView& Chunk);
+	void UpdateSwitches();
+
+	FString FileName;
+	FActorXChunkDirectory Directory;
+	
+};
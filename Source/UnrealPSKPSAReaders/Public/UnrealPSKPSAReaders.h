@@ -0,0 +1,9 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * The ActorX readers only depend on Core so they can be linked from programs as well as from the editor importer.
+ */
+DECLARE_LOG_CATEGORY_EXTERN(LogActorXReader, Log, All);
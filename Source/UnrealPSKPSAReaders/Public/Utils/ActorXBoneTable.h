@@ -0,0 +1,46 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Utils/ActorXModels.h"
+
+/** A bone of the table, indices refer to the table and not to the file */
+struct FActorXBone
+{
+	FName Name;
+	int32 FileIndex = INDEX_NONE;
+	int32 ParentIndex = INDEX_NONE;
+	int32 NumChildren = 0;
+	int32 Depth = 1;
+};
+
+/**
+ * Bones of a PSK without the duplicates UModel sometimes writes, built in one pass over the file's bones.
+ * Bones are looked up by name through a hash, every file index maps to the bone it ended up as,
+ * so influences and parents pointing at a duplicate land on the first bone with that name.
+ */
+class UNREALPSKPSAREADERS_API FActorXBoneTable
+{
+public:
+	void Build(TConstArrayView<VNamedBoneBinary> FileBones);
+
+	/** Table index of a file bone index, INDEX_NONE when it is outside the file's bones */
+	int32 Remap(int32 FileIndex) const
+	{
+		return FileToTable.IsValidIndex(FileIndex) ? FileToTable[FileIndex] : INDEX_NONE;
+	}
+
+	int32 Find(FName Name) const
+	{
+		const auto Found = IndexByName.Find(Name);
+		return Found ? *Found : INDEX_NONE;
+	}
+
+	TArray<FActorXBone> Bones;
+	TArray<int32> FileToTable;
+	TMap<FName, int32> IndexByName;
+
+	int32 MaxDepth = 0;
+	int32 NumDuplicates = 0;
+
+	/** Bones whose parent was missing or came after them, they are attached to the root instead */
+	int32 NumReparented = 0;
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Converts ActorX data into Unreal's coordinate system. ActorX is mirrored on the Y axis,
+ * and every rotation except the root bone's has its handedness flipped.
+ *
+ * The bulk functions are vectorised through VectorRegister, the scalar versions are kept as the reference
+ * implementation and are used instead when ActorX.ScalarConversion is set.
+ */
+class UNREALPSKPSAREADERS_API FActorXConversion
+{
+public:
+	/** Mirrors points in place and returns the bounds of the mirrored points */
+	static FBox3f MirrorPoints(TArrayView<FVector3f> Points);
+
+	/** Mirrors positions or normals in place */
+	static void MirrorVectors(TArrayView<FVector3f> Vectors);
+
+	/** Flips and normalises rotations in place */
+	static void ConvertRotations(TArrayView<FQuat4f> Rotations, bool bRootBone);
+
+	static FVector3f MirrorVector(const FVector3f& Vector)
+	{
+		return FVector3f(Vector.X, -Vector.Y, Vector.Z);
+	}
+
+	static FQuat4f ConvertRotation(const FQuat4f& Rotation, bool bRootBone)
+	{
+		return FQuat4f(-Rotation.X, Rotation.Y, -Rotation.Z, bRootBone ? Rotation.W : -Rotation.W).GetNormalized();
+	}
+
+	// Scalar reference implementations
+	static FBox3f MirrorPointsScalar(TArrayView<FVector3f> Points);
+	static void MirrorVectorsScalar(TArrayView<FVector3f> Vectors);
+	static void ConvertRotationsScalar(TArrayView<FQuat4f> Rotations, bool bRootBone);
+};
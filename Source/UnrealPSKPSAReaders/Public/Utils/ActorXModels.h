@@ -0,0 +1,108 @@
+﻿#pragma once
+#include "CoreMinimal.h"
+
+/** Packs the first eight characters of a chunk name into an integer so chunk lookups are a single compare */
+constexpr uint64 ActorXChunkId(const char* Name)
+{
+	uint64 Id = 0;
+	for (auto i = 0; i < 8 && Name[i] != '\0'; i++)
+	{
+		Id |= static_cast<uint64>(static_cast<uint8>(Name[i])) << (i * 8);
+	}
+
+	return Id;
+}
+
+/** Same limit as the engine's MAX_TEXCOORDS, which isn't available to a Core-only module */
+constexpr int32 ActorXMaxUVSets = 8;
+
+struct VChunkHeader
+{
+	char ChunkID[20];
+	int TypeFlag;
+	int DataSize;
+	int DataCount;
+};
+
+struct VVertex
+{
+	int PointIndex;
+	float U, V;
+	char MatIndex;
+	char Reserved;
+	short Pad;
+};
+
+struct VTriangle
+{
+	int WedgeIndex[3];
+	char MatIndex;
+	char AuxMatIndex;
+	unsigned SmoothingGroups;
+};
+
+struct VMaterial
+{
+	char MaterialName[64];
+	int TextureIndex;
+	unsigned PolyFlags;
+	int AuxMaterial;
+	unsigned AuxFlags;
+	int LodBias;
+	int LodStyle;
+};
+
+struct VJointPos
+{
+	FQuat4f Orientation;
+	FVector3f Position;
+	float Length;
+	float XSize;
+	float YSize;
+	float ZSize;
+};
+
+struct VNamedBoneBinary
+{
+	char Name[64];
+	int Flags;
+	int NumChildren;
+	int ParentIndex;
+	VJointPos BonePos;
+};
+
+struct VRawBoneInfluence
+{
+	float Weight;
+	int PointIdx;
+	int BoneIdx;
+};
+
+struct VAnimInfoBinary
+{
+	char Name[64];
+	char Group[64];
+	int TotalBones;
+	int RootInclude;
+	int KeyCompressionStyle;
+	int KeyQuotum;
+	float KeyReduction;
+	float TrackTime;
+	float AnimRate;
+	int StartBone;
+	int FirstRawFrame;
+	int NumRawFrames;
+};
+
+struct VQuatAnimKey
+{
+	FVector3f Position;
+	FQuat4f Orientation;
+	float Time;
+};
+
+struct VAnimScaleKey
+{
+	FVector3f ScaleVector;
+	float Time;
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "Utils/ActorXModels.h"
+
+/**
+ * Skin weights of a mesh as compressed sparse rows. The influences of a point are stored next to each other
+ * from Offsets[Point] to Offsets[Point + 1], strongest first, so looking up a point is two reads.
+ */
+class UNREALPSKPSAREADERS_API FActorXSkinWeights
+{
+public:
+	/**
+	 * Groups the raw influences by point, sums the ones on the same bone, keeps the MaxInfluences strongest
+	 * and drops the ones below WeightThreshold, then renormalises what is left. The strongest influence of a point is always kept.
+	 * Influences on points outside PointCount are dropped.
+	 */
+	void Build(TConstArrayView<VRawBoneInfluence> Influences, int32 PointCount, int32 MaxInfluences, float WeightThreshold, EParallelForFlags Flags = EParallelForFlags::None);
+
+	int32 NumPoints() const { return FMath::Max(Offsets.Num() - 1, 0); }
+	int32 NumInfluences() const { return BoneIndices.Num(); }
+	int32 NumInfluences(int32 Point) const { return Offsets[Point + 1] - Offsets[Point]; }
+
+	TConstArrayView<int32> GetBoneIndices(int32 Point) const { return MakeArrayView(BoneIndices).Slice(Offsets[Point], NumInfluences(Point)); }
+	TConstArrayView<float> GetWeights(int32 Point) const { return MakeArrayView(Weights).Slice(Offsets[Point], NumInfluences(Point)); }
+
+	/** Raw influences that were merged, pruned or pointed outside the mesh */
+	int32 NumPruned = 0;
+
+	/** Most influences left on a single point */
+	int32 MaxPointInfluences = 0;
+
+	/** Points left without any influence */
+	int32 NumUnweightedPoints = 0;
+
+	TArray<int32> Offsets;
+	TArray<int32> BoneIndices;
+	TArray<float> Weights;
+};
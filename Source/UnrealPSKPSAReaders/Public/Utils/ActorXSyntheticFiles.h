@@ -0,0 +1,41 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/** Sizes of the generated files, every count can be overridden on the command line */
+struct UNREALPSKPSAREADERS_API FActorXSyntheticParams
+{
+	int32 Vertices = 100000;
+	int32 Wedges = 150000;
+	int32 Faces = 100000;
+	int32 Materials = 8;
+	int32 UVSets = 2;
+	int32 InfluencesPerVertex = 4;
+	int32 Bones = 128;
+	int32 Sockets = 32;
+	int32 Sequences = 16;
+	int32 Frames = 120;
+	int32 Seed = 0;
+
+	void ParseCommandLine(const TCHAR* CommandLine);
+	FString ToString() const;
+};
+
+/**
+ * Writes deterministic ActorX files with random but valid contents, so the readers can be measured at any
+ * scale without real assets. Faces are written as FACE3200 once there are more wedges than 16 bit indices can address.
+ */
+class UNREALPSKPSAREADERS_API FActorXSyntheticFiles
+{
+public:
+	/** Skeletal mesh with bones, weights and extra UV sets */
+	static bool WritePSK(const FString& Filename, const FActorXSyntheticParams& Params);
+
+	/** Static mesh with normals, vertex colors and extra UV sets */
+	static bool WritePSKX(const FString& Filename, const FActorXSyntheticParams& Params);
+
+	/** Animation with scale keys for every sequence */
+	static bool WritePSA(const FString& Filename, const FActorXSyntheticParams& Params);
+
+	/** UModel properties with sockets, next to an otherwise empty PSK so only the properties are parsed */
+	static bool WriteProps(const FString& Filename, const FActorXSyntheticParams& Params);
+};
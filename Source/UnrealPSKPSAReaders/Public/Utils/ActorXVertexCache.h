@@ -0,0 +1,27 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+
+/**
+ * Orders triangles for the post-transform vertex cache with Tom Forsyth's linear-speed algorithm.
+ * Triangles are given as three vertex indices each (triangle * 3 + corner), the vertices are the wedges the build gets.
+ */
+class UNREALPSKPSAREADERS_API FActorXVertexCache
+{
+public:
+	/** Entries of the simulated cache, used for the scoring and for measuring ACMR */
+	static constexpr int32 CacheSize = 32;
+
+	/**
+	 * Groups the triangles by section, lowest first, and orders the triangles of every section for the vertex cache.
+	 * OutOrder gets the triangle at every new position, sections are independent so they are optimised in parallel.
+	 */
+	static void OptimizeFaceOrder(TConstArrayView<int32> CornerVertices, TConstArrayView<int32> Sections, TArray<int32>& OutOrder, EParallelForFlags Flags = EParallelForFlags::None);
+
+	/** Average cache miss ratio, the transformed vertices per triangle, of the triangles in Order or in their given order when it is empty */
+	static double ComputeACMR(TConstArrayView<int32> CornerVertices, TConstArrayView<int32> Order = {});
+
+private:
+	/** Orders the triangles of one section, whose vertices are numbered from 0 to NumVertices - 1 */
+	static void OptimizeSection(TConstArrayView<int32> CornerVertices, int32 NumVertices, TArray<int32>& OutOrder);
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class PSKReader;
+
+/**
+ * Maps the face corners of a PSK to the wedges handed to the mesh build. Normals and colors are stored per point,
+ * so two corners make the same vertex when they share the point, the material and every UV.
+ *
+ * Both functions fill OutCornerWedges with the output wedge of every corner (face * 3 + corner, in the order of the faces)
+ * and OutSourceWedges with the reader wedge every output wedge is taken from. They run over every face of the reader,
+ * or over the given Faces only, an empty Faces gives no corners at all.
+ */
+class UNREALPSKPSAREADERS_API FActorXWedgeWelding
+{
+public:
+	/**
+	 * Collapses identical corners into one wedge. Wedges are numbered in the order the faces first use them,
+	 * so the result only depends on the file. A corner whose UVs are all within UVTolerance of a kept wedge's, on both axes,
+	 * is welded to the first such wedge. 0 only welds exact matches.
+	 */
+	static void Weld(const PSKReader& Data, float UVTolerance, TArray<int32>& OutCornerWedges, TArray<int32>& OutSourceWedges);
+	static void Weld(const PSKReader& Data, float UVTolerance, TConstArrayView<int32> Faces, TArray<int32>& OutCornerWedges, TArray<int32>& OutSourceWedges);
+
+	/** One wedge per corner, what the build gets without welding */
+	static void MapCorners(const PSKReader& Data, TArray<int32>& OutCornerWedges, TArray<int32>& OutSourceWedges);
+	static void MapCorners(const PSKReader& Data, TConstArrayView<int32> Faces, TArray<int32>& OutCornerWedges, TArray<int32>& OutSourceWedges);
+};